@@ -0,0 +1,9 @@
+; globals for bench/env.lspy: 4096 definitions, to make the global env big
+(def {g0 g1 g2 g3 g4 g5 g6 g7 g8 g9 g10 g11 g12 g13 g14 g15 g16 g17 g18 g19 g20 g21 g22 g23 g24 g25 g26 g27 g28 g29 g30 g31 g32 g33 g34 g35 g36 g37 g38 g39 g40 g41 g42 g43 g44 g45 g46 g47 g48 g49 g50 g51 g52 g53 g54 g55 g56 g57 g58 g59 g60 g61 g62 g63 g64 g65 g66 g67 g68 g69 g70 g71 g72 g73 g74 g75 g76 g77 g78 g79 g80 g81 g82 g83 g84 g85 g86 g87 g88 g89 g90 g91 g92 g93 g94 g95 g96 g97 g98 g99 g100 g101 g102 g103 g104 g105 g106 g107 g108 g109 g110 g111 g112 g113 g114 g115 g116 g117 g118 g119 g120 g121 g122 g123 g124 g125 g126 g127 g128 g129 g130 g131 g132 g133 g134 g135 g136 g137 g138 g139 g140 g141 g142 g143 g144 g145 g146 g147 g148 g149 g150 g151 g152 g153 g154 g155 g156 g157 g158 g159 g160 g161 g162 g163 g164 g165 g166 g167 g168 g169 g170 g171 g172 g173 g174 g175 g176 g177 g178 g179 g180 g181 g182 g183 g184 g185 g186 g187 g188 g189 g190 g191 g192 g193 g194 g195 g196 g197 g198 g199 g200 g201 g202 g203 g204 g205 g206 g207 g208 g209 g210 g211 g212 g213 g214 g215 g216 g217 g218 g219 g220 g221 g222 g223 g224 g225 g226 g227 g228 g229 g230 g231 g232 g233 g234 g235 g236 g237 g238 g239 g240 g241 g242 g243 g244 g245 g246 g247 g248 g249 g250 g251 g252 g253 g254 g255 g256 g257 g258 g259 g260 g261 g262 g263 g264 g265 g266 g267 g268 g269 g270 g271 g272 g273 g274 g275 g276 g277 g278 g279 g280 g281 g282 g283 g284 g285 g286 g287 g288 g289 g290 g291 g292 g293 g294 g295 g296 g297 g298 g299 g300 g301 g302 g303 g304 g305 g306 g307 g308 g309 g310 g311 g312 g313 g314 g315 g316 g317 g318 g319 g320 g321 g322 g323 g324 g325 g326 g327 g328 g329 g330 g331 g332 g333 g334 g335 g336 g337 g338 g339 g340 g341 g342 g343 g344 g345 g346 g347 g348 g349 g350 g351 g352 g353 g354 g355 g356 g357 g358 g359 g360 g361 g362 g363 g364 g365 g366 g367 g368 g369 g370 g371 g372 g373 g374 g375 g376 g377 g378 g379 g380 g381 g382 g383 g384 g385 g386 g387 g388 g389 g390 g391 g392 g393 g394 g395 g396 g397 g398 g399 g400 g401 g402 g403 g404 g405 g406 g407 g408 g409 g410 g411 g412 g413 g414 g415 g416 g417 g418 g419 g420 g421 g422 g423 g424 g425 g426 g427 g428 g429 g430 g431 g432 g433 g434 g435 g436 g437 g438 g439 g440 g441 g442 g443 g444 g445 g446 g447 g448 g449 g450 g451 g452 g453 g454 g455 g456 g457 g458 g459 g460 g461 g462 g463 g464 g465 g466 g467 g468 g469 g470 g471 g472 g473 g474 g475 g476 g477 g478 g479 g480 g481 g482 g483 g484 g485 g486 g487 g488 g489 g490 g491 g492 g493 g494 g495 g496 g497 g498 g499 g500 g501 g502 g503 g504 g505 g506 g507 g508 g509 g510 g511 g512 g513 g514 g515 g516 g517 g518 g519 g520 g521 g522 g523 g524 g525 g526 g527 g528 g529 g530 g531 g532 g533 g534 g535 g536 g537 g538 g539 g540 g541 g542 g543 g544 g545 g546 g547 g548 g549 g550 g551 g552 g553 g554 g555 g556 g557 g558 g559 g560 g561 g562 g563 g564 g565 g566 g567 g568 g569 g570 g571 g572 g573 g574 g575 g576 g577 g578 g579 g580 g581 g582 g583 g584 g585 g586 g587 g588 g589 g590 g591 g592 g593 g594 g595 g596 g597 g598 g599 g600 g601 g602 g603 g604 g605 g606 g607 g608 g609 g610 g611 g612 g613 g614 g615 g616 g617 g618 g619 g620 g621 g622 g623 g624 g625 g626 g627 g628 g629 g630 g631 g632 g633 g634 g635 g636 g637 g638 g639 g640 g641 g642 g643 g644 g645 g646 g647 g648 g649 g650 g651 g652 g653 g654 g655 g656 g657 g658 g659 g660 g661 g662 g663 g664 g665 g666 g667 g668 g669 g670 g671 g672 g673 g674 g675 g676 g677 g678 g679 g680 g681 g682 g683 g684 g685 g686 g687 g688 g689 g690 g691 g692 g693 g694 g695 g696 g697 g698 g699 g700 g701 g702 g703 g704 g705 g706 g707 g708 g709 g710 g711 g712 g713 g714 g715 g716 g717 g718 g719 g720 g721 g722 g723 g724 g725 g726 g727 g728 g729 g730 g731 g732 g733 g734 g735 g736 g737 g738 g739 g740 g741 g742 g743 g744 g745 g746 g747 g748 g749 g750 g751 g752 g753 g754 g755 g756 g757 g758 g759 g760 g761 g762 g763 g764 g765 g766 g767 g768 g769 g770 g771 g772 g773 g774 g775 g776 g777 g778 g779 g780 g781 g782 g783 g784 g785 g786 g787 g788 g789 g790 g791 g792 g793 g794 g795 g796 g797 g798 g799 g800 g801 g802 g803 g804 g805 g806 g807 g808 g809 g810 g811 g812 g813 g814 g815 g816 g817 g818 g819 g820 g821 g822 g823 g824 g825 g826 g827 g828 g829 g830 g831 g832 g833 g834 g835 g836 g837 g838 g839 g840 g841 g842 g843 g844 g845 g846 g847 g848 g849 g850 g851 g852 g853 g854 g855 g856 g857 g858 g859 g860 g861 g862 g863 g864 g865 g866 g867 g868 g869 g870 g871 g872 g873 g874 g875 g876 g877 g878 g879 g880 g881 g882 g883 g884 g885 g886 g887 g888 g889 g890 g891 g892 g893 g894 g895 g896 g897 g898 g899 g900 g901 g902 g903 g904 g905 g906 g907 g908 g909 g910 g911 g912 g913 g914 g915 g916 g917 g918 g919 g920 g921 g922 g923 g924 g925 g926 g927 g928 g929 g930 g931 g932 g933 g934 g935 g936 g937 g938 g939 g940 g941 g942 g943 g944 g945 g946 g947 g948 g949 g950 g951 g952 g953 g954 g955 g956 g957 g958 g959 g960 g961 g962 g963 g964 g965 g966 g967 g968 g969 g970 g971 g972 g973 g974 g975 g976 g977 g978 g979 g980 g981 g982 g983 g984 g985 g986 g987 g988 g989 g990 g991 g992 g993 g994 g995 g996 g997 g998 g999 g1000 g1001 g1002 g1003 g1004 g1005 g1006 g1007 g1008 g1009 g1010 g1011 g1012 g1013 g1014 g1015 g1016 g1017 g1018 g1019 g1020 g1021 g1022 g1023}
+  0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35 36 37 38 39 40 41 42 43 44 45 46 47 48 49 50 51 52 53 54 55 56 57 58 59 60 61 62 63 64 65 66 67 68 69 70 71 72 73 74 75 76 77 78 79 80 81 82 83 84 85 86 87 88 89 90 91 92 93 94 95 96 97 98 99 100 101 102 103 104 105 106 107 108 109 110 111 112 113 114 115 116 117 118 119 120 121 122 123 124 125 126 127 128 129 130 131 132 133 134 135 136 137 138 139 140 141 142 143 144 145 146 147 148 149 150 151 152 153 154 155 156 157 158 159 160 161 162 163 164 165 166 167 168 169 170 171 172 173 174 175 176 177 178 179 180 181 182 183 184 185 186 187 188 189 190 191 192 193 194 195 196 197 198 199 200 201 202 203 204 205 206 207 208 209 210 211 212 213 214 215 216 217 218 219 220 221 222 223 224 225 226 227 228 229 230 231 232 233 234 235 236 237 238 239 240 241 242 243 244 245 246 247 248 249 250 251 252 253 254 255 256 257 258 259 260 261 262 263 264 265 266 267 268 269 270 271 272 273 274 275 276 277 278 279 280 281 282 283 284 285 286 287 288 289 290 291 292 293 294 295 296 297 298 299 300 301 302 303 304 305 306 307 308 309 310 311 312 313 314 315 316 317 318 319 320 321 322 323 324 325 326 327 328 329 330 331 332 333 334 335 336 337 338 339 340 341 342 343 344 345 346 347 348 349 350 351 352 353 354 355 356 357 358 359 360 361 362 363 364 365 366 367 368 369 370 371 372 373 374 375 376 377 378 379 380 381 382 383 384 385 386 387 388 389 390 391 392 393 394 395 396 397 398 399 400 401 402 403 404 405 406 407 408 409 410 411 412 413 414 415 416 417 418 419 420 421 422 423 424 425 426 427 428 429 430 431 432 433 434 435 436 437 438 439 440 441 442 443 444 445 446 447 448 449 450 451 452 453 454 455 456 457 458 459 460 461 462 463 464 465 466 467 468 469 470 471 472 473 474 475 476 477 478 479 480 481 482 483 484 485 486 487 488 489 490 491 492 493 494 495 496 497 498 499 500 501 502 503 504 505 506 507 508 509 510 511 512 513 514 515 516 517 518 519 520 521 522 523 524 525 526 527 528 529 530 531 532 533 534 535 536 537 538 539 540 541 542 543 544 545 546 547 548 549 550 551 552 553 554 555 556 557 558 559 560 561 562 563 564 565 566 567 568 569 570 571 572 573 574 575 576 577 578 579 580 581 582 583 584 585 586 587 588 589 590 591 592 593 594 595 596 597 598 599 600 601 602 603 604 605 606 607 608 609 610 611 612 613 614 615 616 617 618 619 620 621 622 623 624 625 626 627 628 629 630 631 632 633 634 635 636 637 638 639 640 641 642 643 644 645 646 647 648 649 650 651 652 653 654 655 656 657 658 659 660 661 662 663 664 665 666 667 668 669 670 671 672 673 674 675 676 677 678 679 680 681 682 683 684 685 686 687 688 689 690 691 692 693 694 695 696 697 698 699 700 701 702 703 704 705 706 707 708 709 710 711 712 713 714 715 716 717 718 719 720 721 722 723 724 725 726 727 728 729 730 731 732 733 734 735 736 737 738 739 740 741 742 743 744 745 746 747 748 749 750 751 752 753 754 755 756 757 758 759 760 761 762 763 764 765 766 767 768 769 770 771 772 773 774 775 776 777 778 779 780 781 782 783 784 785 786 787 788 789 790 791 792 793 794 795 796 797 798 799 800 801 802 803 804 805 806 807 808 809 810 811 812 813 814 815 816 817 818 819 820 821 822 823 824 825 826 827 828 829 830 831 832 833 834 835 836 837 838 839 840 841 842 843 844 845 846 847 848 849 850 851 852 853 854 855 856 857 858 859 860 861 862 863 864 865 866 867 868 869 870 871 872 873 874 875 876 877 878 879 880 881 882 883 884 885 886 887 888 889 890 891 892 893 894 895 896 897 898 899 900 901 902 903 904 905 906 907 908 909 910 911 912 913 914 915 916 917 918 919 920 921 922 923 924 925 926 927 928 929 930 931 932 933 934 935 936 937 938 939 940 941 942 943 944 945 946 947 948 949 950 951 952 953 954 955 956 957 958 959 960 961 962 963 964 965 966 967 968 969 970 971 972 973 974 975 976 977 978 979 980 981 982 983 984 985 986 987 988 989 990 991 992 993 994 995 996 997 998 999 1000 1001 1002 1003 1004 1005 1006 1007 1008 1009 1010 1011 1012 1013 1014 1015 1016 1017 1018 1019 1020 1021 1022 1023)
+(def {g1024 g1025 g1026 g1027 g1028 g1029 g1030 g1031 g1032 g1033 g1034 g1035 g1036 g1037 g1038 g1039 g1040 g1041 g1042 g1043 g1044 g1045 g1046 g1047 g1048 g1049 g1050 g1051 g1052 g1053 g1054 g1055 g1056 g1057 g1058 g1059 g1060 g1061 g1062 g1063 g1064 g1065 g1066 g1067 g1068 g1069 g1070 g1071 g1072 g1073 g1074 g1075 g1076 g1077 g1078 g1079 g1080 g1081 g1082 g1083 g1084 g1085 g1086 g1087 g1088 g1089 g1090 g1091 g1092 g1093 g1094 g1095 g1096 g1097 g1098 g1099 g1100 g1101 g1102 g1103 g1104 g1105 g1106 g1107 g1108 g1109 g1110 g1111 g1112 g1113 g1114 g1115 g1116 g1117 g1118 g1119 g1120 g1121 g1122 g1123 g1124 g1125 g1126 g1127 g1128 g1129 g1130 g1131 g1132 g1133 g1134 g1135 g1136 g1137 g1138 g1139 g1140 g1141 g1142 g1143 g1144 g1145 g1146 g1147 g1148 g1149 g1150 g1151 g1152 g1153 g1154 g1155 g1156 g1157 g1158 g1159 g1160 g1161 g1162 g1163 g1164 g1165 g1166 g1167 g1168 g1169 g1170 g1171 g1172 g1173 g1174 g1175 g1176 g1177 g1178 g1179 g1180 g1181 g1182 g1183 g1184 g1185 g1186 g1187 g1188 g1189 g1190 g1191 g1192 g1193 g1194 g1195 g1196 g1197 g1198 g1199 g1200 g1201 g1202 g1203 g1204 g1205 g1206 g1207 g1208 g1209 g1210 g1211 g1212 g1213 g1214 g1215 g1216 g1217 g1218 g1219 g1220 g1221 g1222 g1223 g1224 g1225 g1226 g1227 g1228 g1229 g1230 g1231 g1232 g1233 g1234 g1235 g1236 g1237 g1238 g1239 g1240 g1241 g1242 g1243 g1244 g1245 g1246 g1247 g1248 g1249 g1250 g1251 g1252 g1253 g1254 g1255 g1256 g1257 g1258 g1259 g1260 g1261 g1262 g1263 g1264 g1265 g1266 g1267 g1268 g1269 g1270 g1271 g1272 g1273 g1274 g1275 g1276 g1277 g1278 g1279 g1280 g1281 g1282 g1283 g1284 g1285 g1286 g1287 g1288 g1289 g1290 g1291 g1292 g1293 g1294 g1295 g1296 g1297 g1298 g1299 g1300 g1301 g1302 g1303 g1304 g1305 g1306 g1307 g1308 g1309 g1310 g1311 g1312 g1313 g1314 g1315 g1316 g1317 g1318 g1319 g1320 g1321 g1322 g1323 g1324 g1325 g1326 g1327 g1328 g1329 g1330 g1331 g1332 g1333 g1334 g1335 g1336 g1337 g1338 g1339 g1340 g1341 g1342 g1343 g1344 g1345 g1346 g1347 g1348 g1349 g1350 g1351 g1352 g1353 g1354 g1355 g1356 g1357 g1358 g1359 g1360 g1361 g1362 g1363 g1364 g1365 g1366 g1367 g1368 g1369 g1370 g1371 g1372 g1373 g1374 g1375 g1376 g1377 g1378 g1379 g1380 g1381 g1382 g1383 g1384 g1385 g1386 g1387 g1388 g1389 g1390 g1391 g1392 g1393 g1394 g1395 g1396 g1397 g1398 g1399 g1400 g1401 g1402 g1403 g1404 g1405 g1406 g1407 g1408 g1409 g1410 g1411 g1412 g1413 g1414 g1415 g1416 g1417 g1418 g1419 g1420 g1421 g1422 g1423 g1424 g1425 g1426 g1427 g1428 g1429 g1430 g1431 g1432 g1433 g1434 g1435 g1436 g1437 g1438 g1439 g1440 g1441 g1442 g1443 g1444 g1445 g1446 g1447 g1448 g1449 g1450 g1451 g1452 g1453 g1454 g1455 g1456 g1457 g1458 g1459 g1460 g1461 g1462 g1463 g1464 g1465 g1466 g1467 g1468 g1469 g1470 g1471 g1472 g1473 g1474 g1475 g1476 g1477 g1478 g1479 g1480 g1481 g1482 g1483 g1484 g1485 g1486 g1487 g1488 g1489 g1490 g1491 g1492 g1493 g1494 g1495 g1496 g1497 g1498 g1499 g1500 g1501 g1502 g1503 g1504 g1505 g1506 g1507 g1508 g1509 g1510 g1511 g1512 g1513 g1514 g1515 g1516 g1517 g1518 g1519 g1520 g1521 g1522 g1523 g1524 g1525 g1526 g1527 g1528 g1529 g1530 g1531 g1532 g1533 g1534 g1535 g1536 g1537 g1538 g1539 g1540 g1541 g1542 g1543 g1544 g1545 g1546 g1547 g1548 g1549 g1550 g1551 g1552 g1553 g1554 g1555 g1556 g1557 g1558 g1559 g1560 g1561 g1562 g1563 g1564 g1565 g1566 g1567 g1568 g1569 g1570 g1571 g1572 g1573 g1574 g1575 g1576 g1577 g1578 g1579 g1580 g1581 g1582 g1583 g1584 g1585 g1586 g1587 g1588 g1589 g1590 g1591 g1592 g1593 g1594 g1595 g1596 g1597 g1598 g1599 g1600 g1601 g1602 g1603 g1604 g1605 g1606 g1607 g1608 g1609 g1610 g1611 g1612 g1613 g1614 g1615 g1616 g1617 g1618 g1619 g1620 g1621 g1622 g1623 g1624 g1625 g1626 g1627 g1628 g1629 g1630 g1631 g1632 g1633 g1634 g1635 g1636 g1637 g1638 g1639 g1640 g1641 g1642 g1643 g1644 g1645 g1646 g1647 g1648 g1649 g1650 g1651 g1652 g1653 g1654 g1655 g1656 g1657 g1658 g1659 g1660 g1661 g1662 g1663 g1664 g1665 g1666 g1667 g1668 g1669 g1670 g1671 g1672 g1673 g1674 g1675 g1676 g1677 g1678 g1679 g1680 g1681 g1682 g1683 g1684 g1685 g1686 g1687 g1688 g1689 g1690 g1691 g1692 g1693 g1694 g1695 g1696 g1697 g1698 g1699 g1700 g1701 g1702 g1703 g1704 g1705 g1706 g1707 g1708 g1709 g1710 g1711 g1712 g1713 g1714 g1715 g1716 g1717 g1718 g1719 g1720 g1721 g1722 g1723 g1724 g1725 g1726 g1727 g1728 g1729 g1730 g1731 g1732 g1733 g1734 g1735 g1736 g1737 g1738 g1739 g1740 g1741 g1742 g1743 g1744 g1745 g1746 g1747 g1748 g1749 g1750 g1751 g1752 g1753 g1754 g1755 g1756 g1757 g1758 g1759 g1760 g1761 g1762 g1763 g1764 g1765 g1766 g1767 g1768 g1769 g1770 g1771 g1772 g1773 g1774 g1775 g1776 g1777 g1778 g1779 g1780 g1781 g1782 g1783 g1784 g1785 g1786 g1787 g1788 g1789 g1790 g1791 g1792 g1793 g1794 g1795 g1796 g1797 g1798 g1799 g1800 g1801 g1802 g1803 g1804 g1805 g1806 g1807 g1808 g1809 g1810 g1811 g1812 g1813 g1814 g1815 g1816 g1817 g1818 g1819 g1820 g1821 g1822 g1823 g1824 g1825 g1826 g1827 g1828 g1829 g1830 g1831 g1832 g1833 g1834 g1835 g1836 g1837 g1838 g1839 g1840 g1841 g1842 g1843 g1844 g1845 g1846 g1847 g1848 g1849 g1850 g1851 g1852 g1853 g1854 g1855 g1856 g1857 g1858 g1859 g1860 g1861 g1862 g1863 g1864 g1865 g1866 g1867 g1868 g1869 g1870 g1871 g1872 g1873 g1874 g1875 g1876 g1877 g1878 g1879 g1880 g1881 g1882 g1883 g1884 g1885 g1886 g1887 g1888 g1889 g1890 g1891 g1892 g1893 g1894 g1895 g1896 g1897 g1898 g1899 g1900 g1901 g1902 g1903 g1904 g1905 g1906 g1907 g1908 g1909 g1910 g1911 g1912 g1913 g1914 g1915 g1916 g1917 g1918 g1919 g1920 g1921 g1922 g1923 g1924 g1925 g1926 g1927 g1928 g1929 g1930 g1931 g1932 g1933 g1934 g1935 g1936 g1937 g1938 g1939 g1940 g1941 g1942 g1943 g1944 g1945 g1946 g1947 g1948 g1949 g1950 g1951 g1952 g1953 g1954 g1955 g1956 g1957 g1958 g1959 g1960 g1961 g1962 g1963 g1964 g1965 g1966 g1967 g1968 g1969 g1970 g1971 g1972 g1973 g1974 g1975 g1976 g1977 g1978 g1979 g1980 g1981 g1982 g1983 g1984 g1985 g1986 g1987 g1988 g1989 g1990 g1991 g1992 g1993 g1994 g1995 g1996 g1997 g1998 g1999 g2000 g2001 g2002 g2003 g2004 g2005 g2006 g2007 g2008 g2009 g2010 g2011 g2012 g2013 g2014 g2015 g2016 g2017 g2018 g2019 g2020 g2021 g2022 g2023 g2024 g2025 g2026 g2027 g2028 g2029 g2030 g2031 g2032 g2033 g2034 g2035 g2036 g2037 g2038 g2039 g2040 g2041 g2042 g2043 g2044 g2045 g2046 g2047}
+  1024 1025 1026 1027 1028 1029 1030 1031 1032 1033 1034 1035 1036 1037 1038 1039 1040 1041 1042 1043 1044 1045 1046 1047 1048 1049 1050 1051 1052 1053 1054 1055 1056 1057 1058 1059 1060 1061 1062 1063 1064 1065 1066 1067 1068 1069 1070 1071 1072 1073 1074 1075 1076 1077 1078 1079 1080 1081 1082 1083 1084 1085 1086 1087 1088 1089 1090 1091 1092 1093 1094 1095 1096 1097 1098 1099 1100 1101 1102 1103 1104 1105 1106 1107 1108 1109 1110 1111 1112 1113 1114 1115 1116 1117 1118 1119 1120 1121 1122 1123 1124 1125 1126 1127 1128 1129 1130 1131 1132 1133 1134 1135 1136 1137 1138 1139 1140 1141 1142 1143 1144 1145 1146 1147 1148 1149 1150 1151 1152 1153 1154 1155 1156 1157 1158 1159 1160 1161 1162 1163 1164 1165 1166 1167 1168 1169 1170 1171 1172 1173 1174 1175 1176 1177 1178 1179 1180 1181 1182 1183 1184 1185 1186 1187 1188 1189 1190 1191 1192 1193 1194 1195 1196 1197 1198 1199 1200 1201 1202 1203 1204 1205 1206 1207 1208 1209 1210 1211 1212 1213 1214 1215 1216 1217 1218 1219 1220 1221 1222 1223 1224 1225 1226 1227 1228 1229 1230 1231 1232 1233 1234 1235 1236 1237 1238 1239 1240 1241 1242 1243 1244 1245 1246 1247 1248 1249 1250 1251 1252 1253 1254 1255 1256 1257 1258 1259 1260 1261 1262 1263 1264 1265 1266 1267 1268 1269 1270 1271 1272 1273 1274 1275 1276 1277 1278 1279 1280 1281 1282 1283 1284 1285 1286 1287 1288 1289 1290 1291 1292 1293 1294 1295 1296 1297 1298 1299 1300 1301 1302 1303 1304 1305 1306 1307 1308 1309 1310 1311 1312 1313 1314 1315 1316 1317 1318 1319 1320 1321 1322 1323 1324 1325 1326 1327 1328 1329 1330 1331 1332 1333 1334 1335 1336 1337 1338 1339 1340 1341 1342 1343 1344 1345 1346 1347 1348 1349 1350 1351 1352 1353 1354 1355 1356 1357 1358 1359 1360 1361 1362 1363 1364 1365 1366 1367 1368 1369 1370 1371 1372 1373 1374 1375 1376 1377 1378 1379 1380 1381 1382 1383 1384 1385 1386 1387 1388 1389 1390 1391 1392 1393 1394 1395 1396 1397 1398 1399 1400 1401 1402 1403 1404 1405 1406 1407 1408 1409 1410 1411 1412 1413 1414 1415 1416 1417 1418 1419 1420 1421 1422 1423 1424 1425 1426 1427 1428 1429 1430 1431 1432 1433 1434 1435 1436 1437 1438 1439 1440 1441 1442 1443 1444 1445 1446 1447 1448 1449 1450 1451 1452 1453 1454 1455 1456 1457 1458 1459 1460 1461 1462 1463 1464 1465 1466 1467 1468 1469 1470 1471 1472 1473 1474 1475 1476 1477 1478 1479 1480 1481 1482 1483 1484 1485 1486 1487 1488 1489 1490 1491 1492 1493 1494 1495 1496 1497 1498 1499 1500 1501 1502 1503 1504 1505 1506 1507 1508 1509 1510 1511 1512 1513 1514 1515 1516 1517 1518 1519 1520 1521 1522 1523 1524 1525 1526 1527 1528 1529 1530 1531 1532 1533 1534 1535 1536 1537 1538 1539 1540 1541 1542 1543 1544 1545 1546 1547 1548 1549 1550 1551 1552 1553 1554 1555 1556 1557 1558 1559 1560 1561 1562 1563 1564 1565 1566 1567 1568 1569 1570 1571 1572 1573 1574 1575 1576 1577 1578 1579 1580 1581 1582 1583 1584 1585 1586 1587 1588 1589 1590 1591 1592 1593 1594 1595 1596 1597 1598 1599 1600 1601 1602 1603 1604 1605 1606 1607 1608 1609 1610 1611 1612 1613 1614 1615 1616 1617 1618 1619 1620 1621 1622 1623 1624 1625 1626 1627 1628 1629 1630 1631 1632 1633 1634 1635 1636 1637 1638 1639 1640 1641 1642 1643 1644 1645 1646 1647 1648 1649 1650 1651 1652 1653 1654 1655 1656 1657 1658 1659 1660 1661 1662 1663 1664 1665 1666 1667 1668 1669 1670 1671 1672 1673 1674 1675 1676 1677 1678 1679 1680 1681 1682 1683 1684 1685 1686 1687 1688 1689 1690 1691 1692 1693 1694 1695 1696 1697 1698 1699 1700 1701 1702 1703 1704 1705 1706 1707 1708 1709 1710 1711 1712 1713 1714 1715 1716 1717 1718 1719 1720 1721 1722 1723 1724 1725 1726 1727 1728 1729 1730 1731 1732 1733 1734 1735 1736 1737 1738 1739 1740 1741 1742 1743 1744 1745 1746 1747 1748 1749 1750 1751 1752 1753 1754 1755 1756 1757 1758 1759 1760 1761 1762 1763 1764 1765 1766 1767 1768 1769 1770 1771 1772 1773 1774 1775 1776 1777 1778 1779 1780 1781 1782 1783 1784 1785 1786 1787 1788 1789 1790 1791 1792 1793 1794 1795 1796 1797 1798 1799 1800 1801 1802 1803 1804 1805 1806 1807 1808 1809 1810 1811 1812 1813 1814 1815 1816 1817 1818 1819 1820 1821 1822 1823 1824 1825 1826 1827 1828 1829 1830 1831 1832 1833 1834 1835 1836 1837 1838 1839 1840 1841 1842 1843 1844 1845 1846 1847 1848 1849 1850 1851 1852 1853 1854 1855 1856 1857 1858 1859 1860 1861 1862 1863 1864 1865 1866 1867 1868 1869 1870 1871 1872 1873 1874 1875 1876 1877 1878 1879 1880 1881 1882 1883 1884 1885 1886 1887 1888 1889 1890 1891 1892 1893 1894 1895 1896 1897 1898 1899 1900 1901 1902 1903 1904 1905 1906 1907 1908 1909 1910 1911 1912 1913 1914 1915 1916 1917 1918 1919 1920 1921 1922 1923 1924 1925 1926 1927 1928 1929 1930 1931 1932 1933 1934 1935 1936 1937 1938 1939 1940 1941 1942 1943 1944 1945 1946 1947 1948 1949 1950 1951 1952 1953 1954 1955 1956 1957 1958 1959 1960 1961 1962 1963 1964 1965 1966 1967 1968 1969 1970 1971 1972 1973 1974 1975 1976 1977 1978 1979 1980 1981 1982 1983 1984 1985 1986 1987 1988 1989 1990 1991 1992 1993 1994 1995 1996 1997 1998 1999 2000 2001 2002 2003 2004 2005 2006 2007 2008 2009 2010 2011 2012 2013 2014 2015 2016 2017 2018 2019 2020 2021 2022 2023 2024 2025 2026 2027 2028 2029 2030 2031 2032 2033 2034 2035 2036 2037 2038 2039 2040 2041 2042 2043 2044 2045 2046 2047)
+(def {g2048 g2049 g2050 g2051 g2052 g2053 g2054 g2055 g2056 g2057 g2058 g2059 g2060 g2061 g2062 g2063 g2064 g2065 g2066 g2067 g2068 g2069 g2070 g2071 g2072 g2073 g2074 g2075 g2076 g2077 g2078 g2079 g2080 g2081 g2082 g2083 g2084 g2085 g2086 g2087 g2088 g2089 g2090 g2091 g2092 g2093 g2094 g2095 g2096 g2097 g2098 g2099 g2100 g2101 g2102 g2103 g2104 g2105 g2106 g2107 g2108 g2109 g2110 g2111 g2112 g2113 g2114 g2115 g2116 g2117 g2118 g2119 g2120 g2121 g2122 g2123 g2124 g2125 g2126 g2127 g2128 g2129 g2130 g2131 g2132 g2133 g2134 g2135 g2136 g2137 g2138 g2139 g2140 g2141 g2142 g2143 g2144 g2145 g2146 g2147 g2148 g2149 g2150 g2151 g2152 g2153 g2154 g2155 g2156 g2157 g2158 g2159 g2160 g2161 g2162 g2163 g2164 g2165 g2166 g2167 g2168 g2169 g2170 g2171 g2172 g2173 g2174 g2175 g2176 g2177 g2178 g2179 g2180 g2181 g2182 g2183 g2184 g2185 g2186 g2187 g2188 g2189 g2190 g2191 g2192 g2193 g2194 g2195 g2196 g2197 g2198 g2199 g2200 g2201 g2202 g2203 g2204 g2205 g2206 g2207 g2208 g2209 g2210 g2211 g2212 g2213 g2214 g2215 g2216 g2217 g2218 g2219 g2220 g2221 g2222 g2223 g2224 g2225 g2226 g2227 g2228 g2229 g2230 g2231 g2232 g2233 g2234 g2235 g2236 g2237 g2238 g2239 g2240 g2241 g2242 g2243 g2244 g2245 g2246 g2247 g2248 g2249 g2250 g2251 g2252 g2253 g2254 g2255 g2256 g2257 g2258 g2259 g2260 g2261 g2262 g2263 g2264 g2265 g2266 g2267 g2268 g2269 g2270 g2271 g2272 g2273 g2274 g2275 g2276 g2277 g2278 g2279 g2280 g2281 g2282 g2283 g2284 g2285 g2286 g2287 g2288 g2289 g2290 g2291 g2292 g2293 g2294 g2295 g2296 g2297 g2298 g2299 g2300 g2301 g2302 g2303 g2304 g2305 g2306 g2307 g2308 g2309 g2310 g2311 g2312 g2313 g2314 g2315 g2316 g2317 g2318 g2319 g2320 g2321 g2322 g2323 g2324 g2325 g2326 g2327 g2328 g2329 g2330 g2331 g2332 g2333 g2334 g2335 g2336 g2337 g2338 g2339 g2340 g2341 g2342 g2343 g2344 g2345 g2346 g2347 g2348 g2349 g2350 g2351 g2352 g2353 g2354 g2355 g2356 g2357 g2358 g2359 g2360 g2361 g2362 g2363 g2364 g2365 g2366 g2367 g2368 g2369 g2370 g2371 g2372 g2373 g2374 g2375 g2376 g2377 g2378 g2379 g2380 g2381 g2382 g2383 g2384 g2385 g2386 g2387 g2388 g2389 g2390 g2391 g2392 g2393 g2394 g2395 g2396 g2397 g2398 g2399 g2400 g2401 g2402 g2403 g2404 g2405 g2406 g2407 g2408 g2409 g2410 g2411 g2412 g2413 g2414 g2415 g2416 g2417 g2418 g2419 g2420 g2421 g2422 g2423 g2424 g2425 g2426 g2427 g2428 g2429 g2430 g2431 g2432 g2433 g2434 g2435 g2436 g2437 g2438 g2439 g2440 g2441 g2442 g2443 g2444 g2445 g2446 g2447 g2448 g2449 g2450 g2451 g2452 g2453 g2454 g2455 g2456 g2457 g2458 g2459 g2460 g2461 g2462 g2463 g2464 g2465 g2466 g2467 g2468 g2469 g2470 g2471 g2472 g2473 g2474 g2475 g2476 g2477 g2478 g2479 g2480 g2481 g2482 g2483 g2484 g2485 g2486 g2487 g2488 g2489 g2490 g2491 g2492 g2493 g2494 g2495 g2496 g2497 g2498 g2499 g2500 g2501 g2502 g2503 g2504 g2505 g2506 g2507 g2508 g2509 g2510 g2511 g2512 g2513 g2514 g2515 g2516 g2517 g2518 g2519 g2520 g2521 g2522 g2523 g2524 g2525 g2526 g2527 g2528 g2529 g2530 g2531 g2532 g2533 g2534 g2535 g2536 g2537 g2538 g2539 g2540 g2541 g2542 g2543 g2544 g2545 g2546 g2547 g2548 g2549 g2550 g2551 g2552 g2553 g2554 g2555 g2556 g2557 g2558 g2559 g2560 g2561 g2562 g2563 g2564 g2565 g2566 g2567 g2568 g2569 g2570 g2571 g2572 g2573 g2574 g2575 g2576 g2577 g2578 g2579 g2580 g2581 g2582 g2583 g2584 g2585 g2586 g2587 g2588 g2589 g2590 g2591 g2592 g2593 g2594 g2595 g2596 g2597 g2598 g2599 g2600 g2601 g2602 g2603 g2604 g2605 g2606 g2607 g2608 g2609 g2610 g2611 g2612 g2613 g2614 g2615 g2616 g2617 g2618 g2619 g2620 g2621 g2622 g2623 g2624 g2625 g2626 g2627 g2628 g2629 g2630 g2631 g2632 g2633 g2634 g2635 g2636 g2637 g2638 g2639 g2640 g2641 g2642 g2643 g2644 g2645 g2646 g2647 g2648 g2649 g2650 g2651 g2652 g2653 g2654 g2655 g2656 g2657 g2658 g2659 g2660 g2661 g2662 g2663 g2664 g2665 g2666 g2667 g2668 g2669 g2670 g2671 g2672 g2673 g2674 g2675 g2676 g2677 g2678 g2679 g2680 g2681 g2682 g2683 g2684 g2685 g2686 g2687 g2688 g2689 g2690 g2691 g2692 g2693 g2694 g2695 g2696 g2697 g2698 g2699 g2700 g2701 g2702 g2703 g2704 g2705 g2706 g2707 g2708 g2709 g2710 g2711 g2712 g2713 g2714 g2715 g2716 g2717 g2718 g2719 g2720 g2721 g2722 g2723 g2724 g2725 g2726 g2727 g2728 g2729 g2730 g2731 g2732 g2733 g2734 g2735 g2736 g2737 g2738 g2739 g2740 g2741 g2742 g2743 g2744 g2745 g2746 g2747 g2748 g2749 g2750 g2751 g2752 g2753 g2754 g2755 g2756 g2757 g2758 g2759 g2760 g2761 g2762 g2763 g2764 g2765 g2766 g2767 g2768 g2769 g2770 g2771 g2772 g2773 g2774 g2775 g2776 g2777 g2778 g2779 g2780 g2781 g2782 g2783 g2784 g2785 g2786 g2787 g2788 g2789 g2790 g2791 g2792 g2793 g2794 g2795 g2796 g2797 g2798 g2799 g2800 g2801 g2802 g2803 g2804 g2805 g2806 g2807 g2808 g2809 g2810 g2811 g2812 g2813 g2814 g2815 g2816 g2817 g2818 g2819 g2820 g2821 g2822 g2823 g2824 g2825 g2826 g2827 g2828 g2829 g2830 g2831 g2832 g2833 g2834 g2835 g2836 g2837 g2838 g2839 g2840 g2841 g2842 g2843 g2844 g2845 g2846 g2847 g2848 g2849 g2850 g2851 g2852 g2853 g2854 g2855 g2856 g2857 g2858 g2859 g2860 g2861 g2862 g2863 g2864 g2865 g2866 g2867 g2868 g2869 g2870 g2871 g2872 g2873 g2874 g2875 g2876 g2877 g2878 g2879 g2880 g2881 g2882 g2883 g2884 g2885 g2886 g2887 g2888 g2889 g2890 g2891 g2892 g2893 g2894 g2895 g2896 g2897 g2898 g2899 g2900 g2901 g2902 g2903 g2904 g2905 g2906 g2907 g2908 g2909 g2910 g2911 g2912 g2913 g2914 g2915 g2916 g2917 g2918 g2919 g2920 g2921 g2922 g2923 g2924 g2925 g2926 g2927 g2928 g2929 g2930 g2931 g2932 g2933 g2934 g2935 g2936 g2937 g2938 g2939 g2940 g2941 g2942 g2943 g2944 g2945 g2946 g2947 g2948 g2949 g2950 g2951 g2952 g2953 g2954 g2955 g2956 g2957 g2958 g2959 g2960 g2961 g2962 g2963 g2964 g2965 g2966 g2967 g2968 g2969 g2970 g2971 g2972 g2973 g2974 g2975 g2976 g2977 g2978 g2979 g2980 g2981 g2982 g2983 g2984 g2985 g2986 g2987 g2988 g2989 g2990 g2991 g2992 g2993 g2994 g2995 g2996 g2997 g2998 g2999 g3000 g3001 g3002 g3003 g3004 g3005 g3006 g3007 g3008 g3009 g3010 g3011 g3012 g3013 g3014 g3015 g3016 g3017 g3018 g3019 g3020 g3021 g3022 g3023 g3024 g3025 g3026 g3027 g3028 g3029 g3030 g3031 g3032 g3033 g3034 g3035 g3036 g3037 g3038 g3039 g3040 g3041 g3042 g3043 g3044 g3045 g3046 g3047 g3048 g3049 g3050 g3051 g3052 g3053 g3054 g3055 g3056 g3057 g3058 g3059 g3060 g3061 g3062 g3063 g3064 g3065 g3066 g3067 g3068 g3069 g3070 g3071}
+  2048 2049 2050 2051 2052 2053 2054 2055 2056 2057 2058 2059 2060 2061 2062 2063 2064 2065 2066 2067 2068 2069 2070 2071 2072 2073 2074 2075 2076 2077 2078 2079 2080 2081 2082 2083 2084 2085 2086 2087 2088 2089 2090 2091 2092 2093 2094 2095 2096 2097 2098 2099 2100 2101 2102 2103 2104 2105 2106 2107 2108 2109 2110 2111 2112 2113 2114 2115 2116 2117 2118 2119 2120 2121 2122 2123 2124 2125 2126 2127 2128 2129 2130 2131 2132 2133 2134 2135 2136 2137 2138 2139 2140 2141 2142 2143 2144 2145 2146 2147 2148 2149 2150 2151 2152 2153 2154 2155 2156 2157 2158 2159 2160 2161 2162 2163 2164 2165 2166 2167 2168 2169 2170 2171 2172 2173 2174 2175 2176 2177 2178 2179 2180 2181 2182 2183 2184 2185 2186 2187 2188 2189 2190 2191 2192 2193 2194 2195 2196 2197 2198 2199 2200 2201 2202 2203 2204 2205 2206 2207 2208 2209 2210 2211 2212 2213 2214 2215 2216 2217 2218 2219 2220 2221 2222 2223 2224 2225 2226 2227 2228 2229 2230 2231 2232 2233 2234 2235 2236 2237 2238 2239 2240 2241 2242 2243 2244 2245 2246 2247 2248 2249 2250 2251 2252 2253 2254 2255 2256 2257 2258 2259 2260 2261 2262 2263 2264 2265 2266 2267 2268 2269 2270 2271 2272 2273 2274 2275 2276 2277 2278 2279 2280 2281 2282 2283 2284 2285 2286 2287 2288 2289 2290 2291 2292 2293 2294 2295 2296 2297 2298 2299 2300 2301 2302 2303 2304 2305 2306 2307 2308 2309 2310 2311 2312 2313 2314 2315 2316 2317 2318 2319 2320 2321 2322 2323 2324 2325 2326 2327 2328 2329 2330 2331 2332 2333 2334 2335 2336 2337 2338 2339 2340 2341 2342 2343 2344 2345 2346 2347 2348 2349 2350 2351 2352 2353 2354 2355 2356 2357 2358 2359 2360 2361 2362 2363 2364 2365 2366 2367 2368 2369 2370 2371 2372 2373 2374 2375 2376 2377 2378 2379 2380 2381 2382 2383 2384 2385 2386 2387 2388 2389 2390 2391 2392 2393 2394 2395 2396 2397 2398 2399 2400 2401 2402 2403 2404 2405 2406 2407 2408 2409 2410 2411 2412 2413 2414 2415 2416 2417 2418 2419 2420 2421 2422 2423 2424 2425 2426 2427 2428 2429 2430 2431 2432 2433 2434 2435 2436 2437 2438 2439 2440 2441 2442 2443 2444 2445 2446 2447 2448 2449 2450 2451 2452 2453 2454 2455 2456 2457 2458 2459 2460 2461 2462 2463 2464 2465 2466 2467 2468 2469 2470 2471 2472 2473 2474 2475 2476 2477 2478 2479 2480 2481 2482 2483 2484 2485 2486 2487 2488 2489 2490 2491 2492 2493 2494 2495 2496 2497 2498 2499 2500 2501 2502 2503 2504 2505 2506 2507 2508 2509 2510 2511 2512 2513 2514 2515 2516 2517 2518 2519 2520 2521 2522 2523 2524 2525 2526 2527 2528 2529 2530 2531 2532 2533 2534 2535 2536 2537 2538 2539 2540 2541 2542 2543 2544 2545 2546 2547 2548 2549 2550 2551 2552 2553 2554 2555 2556 2557 2558 2559 2560 2561 2562 2563 2564 2565 2566 2567 2568 2569 2570 2571 2572 2573 2574 2575 2576 2577 2578 2579 2580 2581 2582 2583 2584 2585 2586 2587 2588 2589 2590 2591 2592 2593 2594 2595 2596 2597 2598 2599 2600 2601 2602 2603 2604 2605 2606 2607 2608 2609 2610 2611 2612 2613 2614 2615 2616 2617 2618 2619 2620 2621 2622 2623 2624 2625 2626 2627 2628 2629 2630 2631 2632 2633 2634 2635 2636 2637 2638 2639 2640 2641 2642 2643 2644 2645 2646 2647 2648 2649 2650 2651 2652 2653 2654 2655 2656 2657 2658 2659 2660 2661 2662 2663 2664 2665 2666 2667 2668 2669 2670 2671 2672 2673 2674 2675 2676 2677 2678 2679 2680 2681 2682 2683 2684 2685 2686 2687 2688 2689 2690 2691 2692 2693 2694 2695 2696 2697 2698 2699 2700 2701 2702 2703 2704 2705 2706 2707 2708 2709 2710 2711 2712 2713 2714 2715 2716 2717 2718 2719 2720 2721 2722 2723 2724 2725 2726 2727 2728 2729 2730 2731 2732 2733 2734 2735 2736 2737 2738 2739 2740 2741 2742 2743 2744 2745 2746 2747 2748 2749 2750 2751 2752 2753 2754 2755 2756 2757 2758 2759 2760 2761 2762 2763 2764 2765 2766 2767 2768 2769 2770 2771 2772 2773 2774 2775 2776 2777 2778 2779 2780 2781 2782 2783 2784 2785 2786 2787 2788 2789 2790 2791 2792 2793 2794 2795 2796 2797 2798 2799 2800 2801 2802 2803 2804 2805 2806 2807 2808 2809 2810 2811 2812 2813 2814 2815 2816 2817 2818 2819 2820 2821 2822 2823 2824 2825 2826 2827 2828 2829 2830 2831 2832 2833 2834 2835 2836 2837 2838 2839 2840 2841 2842 2843 2844 2845 2846 2847 2848 2849 2850 2851 2852 2853 2854 2855 2856 2857 2858 2859 2860 2861 2862 2863 2864 2865 2866 2867 2868 2869 2870 2871 2872 2873 2874 2875 2876 2877 2878 2879 2880 2881 2882 2883 2884 2885 2886 2887 2888 2889 2890 2891 2892 2893 2894 2895 2896 2897 2898 2899 2900 2901 2902 2903 2904 2905 2906 2907 2908 2909 2910 2911 2912 2913 2914 2915 2916 2917 2918 2919 2920 2921 2922 2923 2924 2925 2926 2927 2928 2929 2930 2931 2932 2933 2934 2935 2936 2937 2938 2939 2940 2941 2942 2943 2944 2945 2946 2947 2948 2949 2950 2951 2952 2953 2954 2955 2956 2957 2958 2959 2960 2961 2962 2963 2964 2965 2966 2967 2968 2969 2970 2971 2972 2973 2974 2975 2976 2977 2978 2979 2980 2981 2982 2983 2984 2985 2986 2987 2988 2989 2990 2991 2992 2993 2994 2995 2996 2997 2998 2999 3000 3001 3002 3003 3004 3005 3006 3007 3008 3009 3010 3011 3012 3013 3014 3015 3016 3017 3018 3019 3020 3021 3022 3023 3024 3025 3026 3027 3028 3029 3030 3031 3032 3033 3034 3035 3036 3037 3038 3039 3040 3041 3042 3043 3044 3045 3046 3047 3048 3049 3050 3051 3052 3053 3054 3055 3056 3057 3058 3059 3060 3061 3062 3063 3064 3065 3066 3067 3068 3069 3070 3071)
+(def {g3072 g3073 g3074 g3075 g3076 g3077 g3078 g3079 g3080 g3081 g3082 g3083 g3084 g3085 g3086 g3087 g3088 g3089 g3090 g3091 g3092 g3093 g3094 g3095 g3096 g3097 g3098 g3099 g3100 g3101 g3102 g3103 g3104 g3105 g3106 g3107 g3108 g3109 g3110 g3111 g3112 g3113 g3114 g3115 g3116 g3117 g3118 g3119 g3120 g3121 g3122 g3123 g3124 g3125 g3126 g3127 g3128 g3129 g3130 g3131 g3132 g3133 g3134 g3135 g3136 g3137 g3138 g3139 g3140 g3141 g3142 g3143 g3144 g3145 g3146 g3147 g3148 g3149 g3150 g3151 g3152 g3153 g3154 g3155 g3156 g3157 g3158 g3159 g3160 g3161 g3162 g3163 g3164 g3165 g3166 g3167 g3168 g3169 g3170 g3171 g3172 g3173 g3174 g3175 g3176 g3177 g3178 g3179 g3180 g3181 g3182 g3183 g3184 g3185 g3186 g3187 g3188 g3189 g3190 g3191 g3192 g3193 g3194 g3195 g3196 g3197 g3198 g3199 g3200 g3201 g3202 g3203 g3204 g3205 g3206 g3207 g3208 g3209 g3210 g3211 g3212 g3213 g3214 g3215 g3216 g3217 g3218 g3219 g3220 g3221 g3222 g3223 g3224 g3225 g3226 g3227 g3228 g3229 g3230 g3231 g3232 g3233 g3234 g3235 g3236 g3237 g3238 g3239 g3240 g3241 g3242 g3243 g3244 g3245 g3246 g3247 g3248 g3249 g3250 g3251 g3252 g3253 g3254 g3255 g3256 g3257 g3258 g3259 g3260 g3261 g3262 g3263 g3264 g3265 g3266 g3267 g3268 g3269 g3270 g3271 g3272 g3273 g3274 g3275 g3276 g3277 g3278 g3279 g3280 g3281 g3282 g3283 g3284 g3285 g3286 g3287 g3288 g3289 g3290 g3291 g3292 g3293 g3294 g3295 g3296 g3297 g3298 g3299 g3300 g3301 g3302 g3303 g3304 g3305 g3306 g3307 g3308 g3309 g3310 g3311 g3312 g3313 g3314 g3315 g3316 g3317 g3318 g3319 g3320 g3321 g3322 g3323 g3324 g3325 g3326 g3327 g3328 g3329 g3330 g3331 g3332 g3333 g3334 g3335 g3336 g3337 g3338 g3339 g3340 g3341 g3342 g3343 g3344 g3345 g3346 g3347 g3348 g3349 g3350 g3351 g3352 g3353 g3354 g3355 g3356 g3357 g3358 g3359 g3360 g3361 g3362 g3363 g3364 g3365 g3366 g3367 g3368 g3369 g3370 g3371 g3372 g3373 g3374 g3375 g3376 g3377 g3378 g3379 g3380 g3381 g3382 g3383 g3384 g3385 g3386 g3387 g3388 g3389 g3390 g3391 g3392 g3393 g3394 g3395 g3396 g3397 g3398 g3399 g3400 g3401 g3402 g3403 g3404 g3405 g3406 g3407 g3408 g3409 g3410 g3411 g3412 g3413 g3414 g3415 g3416 g3417 g3418 g3419 g3420 g3421 g3422 g3423 g3424 g3425 g3426 g3427 g3428 g3429 g3430 g3431 g3432 g3433 g3434 g3435 g3436 g3437 g3438 g3439 g3440 g3441 g3442 g3443 g3444 g3445 g3446 g3447 g3448 g3449 g3450 g3451 g3452 g3453 g3454 g3455 g3456 g3457 g3458 g3459 g3460 g3461 g3462 g3463 g3464 g3465 g3466 g3467 g3468 g3469 g3470 g3471 g3472 g3473 g3474 g3475 g3476 g3477 g3478 g3479 g3480 g3481 g3482 g3483 g3484 g3485 g3486 g3487 g3488 g3489 g3490 g3491 g3492 g3493 g3494 g3495 g3496 g3497 g3498 g3499 g3500 g3501 g3502 g3503 g3504 g3505 g3506 g3507 g3508 g3509 g3510 g3511 g3512 g3513 g3514 g3515 g3516 g3517 g3518 g3519 g3520 g3521 g3522 g3523 g3524 g3525 g3526 g3527 g3528 g3529 g3530 g3531 g3532 g3533 g3534 g3535 g3536 g3537 g3538 g3539 g3540 g3541 g3542 g3543 g3544 g3545 g3546 g3547 g3548 g3549 g3550 g3551 g3552 g3553 g3554 g3555 g3556 g3557 g3558 g3559 g3560 g3561 g3562 g3563 g3564 g3565 g3566 g3567 g3568 g3569 g3570 g3571 g3572 g3573 g3574 g3575 g3576 g3577 g3578 g3579 g3580 g3581 g3582 g3583 g3584 g3585 g3586 g3587 g3588 g3589 g3590 g3591 g3592 g3593 g3594 g3595 g3596 g3597 g3598 g3599 g3600 g3601 g3602 g3603 g3604 g3605 g3606 g3607 g3608 g3609 g3610 g3611 g3612 g3613 g3614 g3615 g3616 g3617 g3618 g3619 g3620 g3621 g3622 g3623 g3624 g3625 g3626 g3627 g3628 g3629 g3630 g3631 g3632 g3633 g3634 g3635 g3636 g3637 g3638 g3639 g3640 g3641 g3642 g3643 g3644 g3645 g3646 g3647 g3648 g3649 g3650 g3651 g3652 g3653 g3654 g3655 g3656 g3657 g3658 g3659 g3660 g3661 g3662 g3663 g3664 g3665 g3666 g3667 g3668 g3669 g3670 g3671 g3672 g3673 g3674 g3675 g3676 g3677 g3678 g3679 g3680 g3681 g3682 g3683 g3684 g3685 g3686 g3687 g3688 g3689 g3690 g3691 g3692 g3693 g3694 g3695 g3696 g3697 g3698 g3699 g3700 g3701 g3702 g3703 g3704 g3705 g3706 g3707 g3708 g3709 g3710 g3711 g3712 g3713 g3714 g3715 g3716 g3717 g3718 g3719 g3720 g3721 g3722 g3723 g3724 g3725 g3726 g3727 g3728 g3729 g3730 g3731 g3732 g3733 g3734 g3735 g3736 g3737 g3738 g3739 g3740 g3741 g3742 g3743 g3744 g3745 g3746 g3747 g3748 g3749 g3750 g3751 g3752 g3753 g3754 g3755 g3756 g3757 g3758 g3759 g3760 g3761 g3762 g3763 g3764 g3765 g3766 g3767 g3768 g3769 g3770 g3771 g3772 g3773 g3774 g3775 g3776 g3777 g3778 g3779 g3780 g3781 g3782 g3783 g3784 g3785 g3786 g3787 g3788 g3789 g3790 g3791 g3792 g3793 g3794 g3795 g3796 g3797 g3798 g3799 g3800 g3801 g3802 g3803 g3804 g3805 g3806 g3807 g3808 g3809 g3810 g3811 g3812 g3813 g3814 g3815 g3816 g3817 g3818 g3819 g3820 g3821 g3822 g3823 g3824 g3825 g3826 g3827 g3828 g3829 g3830 g3831 g3832 g3833 g3834 g3835 g3836 g3837 g3838 g3839 g3840 g3841 g3842 g3843 g3844 g3845 g3846 g3847 g3848 g3849 g3850 g3851 g3852 g3853 g3854 g3855 g3856 g3857 g3858 g3859 g3860 g3861 g3862 g3863 g3864 g3865 g3866 g3867 g3868 g3869 g3870 g3871 g3872 g3873 g3874 g3875 g3876 g3877 g3878 g3879 g3880 g3881 g3882 g3883 g3884 g3885 g3886 g3887 g3888 g3889 g3890 g3891 g3892 g3893 g3894 g3895 g3896 g3897 g3898 g3899 g3900 g3901 g3902 g3903 g3904 g3905 g3906 g3907 g3908 g3909 g3910 g3911 g3912 g3913 g3914 g3915 g3916 g3917 g3918 g3919 g3920 g3921 g3922 g3923 g3924 g3925 g3926 g3927 g3928 g3929 g3930 g3931 g3932 g3933 g3934 g3935 g3936 g3937 g3938 g3939 g3940 g3941 g3942 g3943 g3944 g3945 g3946 g3947 g3948 g3949 g3950 g3951 g3952 g3953 g3954 g3955 g3956 g3957 g3958 g3959 g3960 g3961 g3962 g3963 g3964 g3965 g3966 g3967 g3968 g3969 g3970 g3971 g3972 g3973 g3974 g3975 g3976 g3977 g3978 g3979 g3980 g3981 g3982 g3983 g3984 g3985 g3986 g3987 g3988 g3989 g3990 g3991 g3992 g3993 g3994 g3995 g3996 g3997 g3998 g3999 g4000 g4001 g4002 g4003 g4004 g4005 g4006 g4007 g4008 g4009 g4010 g4011 g4012 g4013 g4014 g4015 g4016 g4017 g4018 g4019 g4020 g4021 g4022 g4023 g4024 g4025 g4026 g4027 g4028 g4029 g4030 g4031 g4032 g4033 g4034 g4035 g4036 g4037 g4038 g4039 g4040 g4041 g4042 g4043 g4044 g4045 g4046 g4047 g4048 g4049 g4050 g4051 g4052 g4053 g4054 g4055 g4056 g4057 g4058 g4059 g4060 g4061 g4062 g4063 g4064 g4065 g4066 g4067 g4068 g4069 g4070 g4071 g4072 g4073 g4074 g4075 g4076 g4077 g4078 g4079 g4080 g4081 g4082 g4083 g4084 g4085 g4086 g4087 g4088 g4089 g4090 g4091 g4092 g4093 g4094 g4095}
+  3072 3073 3074 3075 3076 3077 3078 3079 3080 3081 3082 3083 3084 3085 3086 3087 3088 3089 3090 3091 3092 3093 3094 3095 3096 3097 3098 3099 3100 3101 3102 3103 3104 3105 3106 3107 3108 3109 3110 3111 3112 3113 3114 3115 3116 3117 3118 3119 3120 3121 3122 3123 3124 3125 3126 3127 3128 3129 3130 3131 3132 3133 3134 3135 3136 3137 3138 3139 3140 3141 3142 3143 3144 3145 3146 3147 3148 3149 3150 3151 3152 3153 3154 3155 3156 3157 3158 3159 3160 3161 3162 3163 3164 3165 3166 3167 3168 3169 3170 3171 3172 3173 3174 3175 3176 3177 3178 3179 3180 3181 3182 3183 3184 3185 3186 3187 3188 3189 3190 3191 3192 3193 3194 3195 3196 3197 3198 3199 3200 3201 3202 3203 3204 3205 3206 3207 3208 3209 3210 3211 3212 3213 3214 3215 3216 3217 3218 3219 3220 3221 3222 3223 3224 3225 3226 3227 3228 3229 3230 3231 3232 3233 3234 3235 3236 3237 3238 3239 3240 3241 3242 3243 3244 3245 3246 3247 3248 3249 3250 3251 3252 3253 3254 3255 3256 3257 3258 3259 3260 3261 3262 3263 3264 3265 3266 3267 3268 3269 3270 3271 3272 3273 3274 3275 3276 3277 3278 3279 3280 3281 3282 3283 3284 3285 3286 3287 3288 3289 3290 3291 3292 3293 3294 3295 3296 3297 3298 3299 3300 3301 3302 3303 3304 3305 3306 3307 3308 3309 3310 3311 3312 3313 3314 3315 3316 3317 3318 3319 3320 3321 3322 3323 3324 3325 3326 3327 3328 3329 3330 3331 3332 3333 3334 3335 3336 3337 3338 3339 3340 3341 3342 3343 3344 3345 3346 3347 3348 3349 3350 3351 3352 3353 3354 3355 3356 3357 3358 3359 3360 3361 3362 3363 3364 3365 3366 3367 3368 3369 3370 3371 3372 3373 3374 3375 3376 3377 3378 3379 3380 3381 3382 3383 3384 3385 3386 3387 3388 3389 3390 3391 3392 3393 3394 3395 3396 3397 3398 3399 3400 3401 3402 3403 3404 3405 3406 3407 3408 3409 3410 3411 3412 3413 3414 3415 3416 3417 3418 3419 3420 3421 3422 3423 3424 3425 3426 3427 3428 3429 3430 3431 3432 3433 3434 3435 3436 3437 3438 3439 3440 3441 3442 3443 3444 3445 3446 3447 3448 3449 3450 3451 3452 3453 3454 3455 3456 3457 3458 3459 3460 3461 3462 3463 3464 3465 3466 3467 3468 3469 3470 3471 3472 3473 3474 3475 3476 3477 3478 3479 3480 3481 3482 3483 3484 3485 3486 3487 3488 3489 3490 3491 3492 3493 3494 3495 3496 3497 3498 3499 3500 3501 3502 3503 3504 3505 3506 3507 3508 3509 3510 3511 3512 3513 3514 3515 3516 3517 3518 3519 3520 3521 3522 3523 3524 3525 3526 3527 3528 3529 3530 3531 3532 3533 3534 3535 3536 3537 3538 3539 3540 3541 3542 3543 3544 3545 3546 3547 3548 3549 3550 3551 3552 3553 3554 3555 3556 3557 3558 3559 3560 3561 3562 3563 3564 3565 3566 3567 3568 3569 3570 3571 3572 3573 3574 3575 3576 3577 3578 3579 3580 3581 3582 3583 3584 3585 3586 3587 3588 3589 3590 3591 3592 3593 3594 3595 3596 3597 3598 3599 3600 3601 3602 3603 3604 3605 3606 3607 3608 3609 3610 3611 3612 3613 3614 3615 3616 3617 3618 3619 3620 3621 3622 3623 3624 3625 3626 3627 3628 3629 3630 3631 3632 3633 3634 3635 3636 3637 3638 3639 3640 3641 3642 3643 3644 3645 3646 3647 3648 3649 3650 3651 3652 3653 3654 3655 3656 3657 3658 3659 3660 3661 3662 3663 3664 3665 3666 3667 3668 3669 3670 3671 3672 3673 3674 3675 3676 3677 3678 3679 3680 3681 3682 3683 3684 3685 3686 3687 3688 3689 3690 3691 3692 3693 3694 3695 3696 3697 3698 3699 3700 3701 3702 3703 3704 3705 3706 3707 3708 3709 3710 3711 3712 3713 3714 3715 3716 3717 3718 3719 3720 3721 3722 3723 3724 3725 3726 3727 3728 3729 3730 3731 3732 3733 3734 3735 3736 3737 3738 3739 3740 3741 3742 3743 3744 3745 3746 3747 3748 3749 3750 3751 3752 3753 3754 3755 3756 3757 3758 3759 3760 3761 3762 3763 3764 3765 3766 3767 3768 3769 3770 3771 3772 3773 3774 3775 3776 3777 3778 3779 3780 3781 3782 3783 3784 3785 3786 3787 3788 3789 3790 3791 3792 3793 3794 3795 3796 3797 3798 3799 3800 3801 3802 3803 3804 3805 3806 3807 3808 3809 3810 3811 3812 3813 3814 3815 3816 3817 3818 3819 3820 3821 3822 3823 3824 3825 3826 3827 3828 3829 3830 3831 3832 3833 3834 3835 3836 3837 3838 3839 3840 3841 3842 3843 3844 3845 3846 3847 3848 3849 3850 3851 3852 3853 3854 3855 3856 3857 3858 3859 3860 3861 3862 3863 3864 3865 3866 3867 3868 3869 3870 3871 3872 3873 3874 3875 3876 3877 3878 3879 3880 3881 3882 3883 3884 3885 3886 3887 3888 3889 3890 3891 3892 3893 3894 3895 3896 3897 3898 3899 3900 3901 3902 3903 3904 3905 3906 3907 3908 3909 3910 3911 3912 3913 3914 3915 3916 3917 3918 3919 3920 3921 3922 3923 3924 3925 3926 3927 3928 3929 3930 3931 3932 3933 3934 3935 3936 3937 3938 3939 3940 3941 3942 3943 3944 3945 3946 3947 3948 3949 3950 3951 3952 3953 3954 3955 3956 3957 3958 3959 3960 3961 3962 3963 3964 3965 3966 3967 3968 3969 3970 3971 3972 3973 3974 3975 3976 3977 3978 3979 3980 3981 3982 3983 3984 3985 3986 3987 3988 3989 3990 3991 3992 3993 3994 3995 3996 3997 3998 3999 4000 4001 4002 4003 4004 4005 4006 4007 4008 4009 4010 4011 4012 4013 4014 4015 4016 4017 4018 4019 4020 4021 4022 4023 4024 4025 4026 4027 4028 4029 4030 4031 4032 4033 4034 4035 4036 4037 4038 4039 4040 4041 4042 4043 4044 4045 4046 4047 4048 4049 4050 4051 4052 4053 4054 4055 4056 4057 4058 4059 4060 4061 4062 4063 4064 4065 4066 4067 4068 4069 4070 4071 4072 4073 4074 4075 4076 4077 4078 4079 4080 4081 4082 4083 4084 4085 4086 4087 4088 4089 4090 4091 4092 4093 4094 4095)
@@ -1,35 +1,115 @@
 #include "mpc.h"
+#include <stdint.h>
+#include <limits.h>
+#include <stddef.h>
+#include <time.h>
+
+// the JIT emits x86-64 code into mmap'd memory
+#if defined(__x86_64__) && defined(__linux__) && !defined(LISP_NO_JIT)
+#define LISP_JIT
+#include <sys/mman.h>
+#endif
 
 static char buffer[2048];
 
 
 struct lisp_val;
 struct lisp_env;
+struct lisp_code;
 typedef struct lisp_val lisp_val;
 typedef struct lisp_env lisp_env;
-typedef lisp_val*(*lisp_builtin)(lisp_env*, lisp_val*);
-// a lisp "value"
+// builtins get their argc arguments in argv, borrowed from the caller, see lisp_builtin_call
+typedef lisp_val*(*lisp_builtin)(lisp_env*, int, lisp_val**);
+
+// an argument of an error message, for a %s or a %i in its format
+typedef union {
+    char* s;
+    long i;
+} lisp_err_arg;
+#define LISP_ERR_MAX_ARGS 3
+#define LISP_EXPR_INLINE 4
+// a lisp "value". the fields after the type overlap, each type only uses (and allocates) its own.
+// values are shared by reference counting and treated as immutable while refs > 1
 struct lisp_val {
-    int type; 
-    long num;
-    char* err;
-    char* symbol;
-    char* string;
-    lisp_builtin builtin;
-    lisp_env* env;
-    lisp_val* formals;
-    lisp_val* body;
-    int count;
-    struct lisp_val** cell;
+    int type;
+    int refs;
+    union {
+        // LISP_VAL_NUM too big to be unboxed
+        long num;
+        // LISP_VAL_ERR, see create_lv_err
+        struct {
+            int err_code;
+            int err_flags;
+            char* err_fmt;
+            lisp_err_arg err_args[LISP_ERR_MAX_ARGS];
+        };
+        // LISP_VAL_SYMBOL. 'interned' is the unique symbol of the name (itself, for interned
+        // symbols). a reference in a lambda body also has its (depth, slot) in the frames if it
+        // names a formal, or else caches the global binding it found while 'epoch' is current.
+        // 'binds' counts the bindings of an interned symbol outside of the global env
+        struct {
+            char* symbol;
+            int id;
+            short depth;
+            short slot;
+            struct lisp_val* interned;
+            struct lisp_val* cache;
+            long epoch;
+            int binds;
+        };
+        // LISP_VAL_STRING
+        struct lisp_str* str;
+        // LISP_VAL_FUNC: builtins end at 'name', lambdas have builtin == NULL. a builtin takes
+        // min_args to max_args arguments (-1 for any number). the 'code' of a lambda is its body
+        // compiled to bytecode, NULL until it is first called
+        struct {
+            lisp_builtin builtin;
+            short min_args;
+            short max_args;
+            union {
+                char* name;
+                lisp_env* env;
+            };
+            lisp_val* formals;
+            lisp_val* body;
+            struct lisp_code* code;
+        };
+        // LISP_VAL_SEXPR, LISP_VAL_QEXPR. cell has room for cap children; up to
+        // LISP_EXPR_INLINE of them are stored in the val itself, more in a malloced array
+        struct {
+            int count;
+            int cap;
+            struct lisp_val** cell;
+            struct lisp_val* cell_inline[LISP_EXPR_INLINE];
+        };
+    };
 };
 
+// bytes needed by a lisp val whose last used field is 'field'
+#define LISP_VAL_SIZE(field) (offsetof(lisp_val, field) + sizeof(((lisp_val*) 0)->field))
+
+// a frame of bindings. symbols and lisp_vals hold count entries in definition order, with room
+// for cap. small frames (most lambda frames) are searched linearly, which is only pointer compares
+// since symbols are interned. frames with more than LISP_ENV_LINEAR entries also get an open
+// addressed index from symbol id to entry. a frame is shared by reference count (like a lisp val,
+// refs comes right after the type) and copied on write
 struct lisp_env {
-    lisp_env* parent;
+    int type;
+    int refs;
     int count;
-    char** symbols;
+    int cap;
+    int temp;
+    lisp_env* parent;
+    // both in one block of 2 * cap, which 'symbols' points to
+    lisp_val** symbols;
     lisp_val** lisp_vals;
+    // entry + 1 per slot, 0 for an empty slot. NULL for small frames
+    int* index;
+    int index_size;
 };
 
+#define LISP_ENV_LINEAR 8
+
 mpc_parser_t* Number;
 mpc_parser_t* Symbol;
 mpc_parser_t* String;
@@ -41,151 +121,823 @@ mpc_parser_t* Lispy;
 
 enum { LISP_VAL_NUM, LISP_VAL_ERR, LISP_VAL_SYMBOL, 
        LISP_VAL_SEXPR, LISP_VAL_QEXPR, LISP_VAL_FUNC, LISP_VAL_STRING};
-enum { ERROR_DIV_ZERO, ERROR_BAD_OP, ERROR_BAD_NUM };
+enum { ERROR_DIV_ZERO, ERROR_BAD_OP, ERROR_BAD_NUM, ERROR_UNBOUND, ERROR_TYPE, ERROR_ARITY,
+       ERROR_EMPTY, ERROR_BAD_FORMALS, ERROR_NOT_FUNC, ERROR_LOAD, ERROR_DEPTH, ERROR_THROWN };
+enum { LISP_ERR_OWNED = 1, LISP_ERR_STATIC = 2 };
+
+// small numbers are not allocated at all: they are stored directly in the lisp_val pointer.
+// heap lisp vals are always at least word aligned, so a set low bit marks an unboxed number and
+// the remaining bits hold its value. numbers outside of that range fall back to a heap LISP_VAL_NUM.
+#define LISP_FIXNUM_MIN (LONG_MIN >> 1)
+#define LISP_FIXNUM_MAX (LONG_MAX >> 1)
+
+static inline int lisp_val_is_fixnum(lisp_val* v) {
+    return ((uintptr_t) v & 1) != 0;
+}
+
+// type of a lisp val, boxed or not
+static inline int lisp_val_type(lisp_val* v) {
+    return lisp_val_is_fixnum(v) ? LISP_VAL_NUM : v->type;
+}
+
+// value of a lisp number, boxed or not
+static inline long lisp_val_num(lisp_val* v) {
+    return lisp_val_is_fixnum(v) ? (long) ((intptr_t) v >> 1) : v->num;
+}
+
+// evaluation region. most objects created while evaluating a top-level form are dead once the
+// form is done, so while a form is evaluated they are bump allocated from one contiguous region,
+// and the whole region is dropped in O(1) at the end of the form. objects in the region are still
+// reference counted (their children must be released), but freeing one doesn't recycle its slot.
+// values only escape by being stored in an env that outlives the form; lisp_env_put promotes
+// (copies) them to the slabs. once the region is full, the rest of the form allocates from the
+// slabs. -DLISP_REGION_BYTES=0 turns regions off.
+#ifndef LISP_REGION_BYTES
+#define LISP_REGION_BYTES (1 << 20)
+#endif
+
+static __thread char* lisp_region_base = NULL;
+static __thread char* lisp_region_next = NULL;
+static __thread char* lisp_region_end = NULL;
+static __thread int lisp_region_active = 0;
+static __thread int lisp_region_overflowed = 0;
+
+// region counters, reported by the 'mem-stats' builtin
+static __thread long lisp_region_allocs = 0;
+static __thread long lisp_region_high = 0;
+static __thread long lisp_region_overflows = 0;
+
+static inline int lisp_region_contains(void* p) {
+    return (char*) p >= lisp_region_base && (char*) p < lisp_region_end;
+}
+
+// bump allocate from the open region, NULL if there is none or it is full
+static inline void* lisp_region_alloc(size_t size) {
+    if (!lisp_region_active || lisp_region_overflowed) { return NULL; }
+    size = (size + 7) & ~(size_t) 7;
+    if ((size_t) (lisp_region_end - lisp_region_next) < size) {
+        lisp_region_overflowed = 1;
+        lisp_region_overflows++;
+        return NULL;
+    }
+    void* obj = lisp_region_next;
+    lisp_region_next += size;
+    lisp_region_allocs++;
+    return obj;
+}
+
+void lisp_region_open() {
+#if LISP_REGION_BYTES > 0 && !defined(LISP_NO_SLAB)
+    if (lisp_region_base == NULL) {
+        lisp_region_base = malloc(LISP_REGION_BYTES);
+        lisp_region_end = lisp_region_base + LISP_REGION_BYTES;
+    }
+    lisp_region_next = lisp_region_base;
+    lisp_region_active = 1;
+    lisp_region_overflowed = 0;
+#endif
+}
+
+// drop everything allocated in the region
+void lisp_region_drop() {
+    if (!lisp_region_active) { return; }
+    if (lisp_region_next - lisp_region_base > lisp_region_high) {
+        lisp_region_high = lisp_region_next - lisp_region_base;
+    }
+    lisp_region_next = lisp_region_base;
+    lisp_region_active = 0;
+    lisp_region_overflowed = 0;
+}
+
+// slab allocator backing all lisp vals and envs. objects are grouped into size classes of
+// 8 bytes; each class carves its objects out of large slabs and recycles freed objects through
+// a per-thread free list. build with -DLISP_NO_SLAB to go straight to malloc/free instead,
+// e.g. when debugging with valgrind or a sanitizer.
+// every slab object starts with an int tag (a lisp val type, LISP_SLAB_ENV or LISP_SLAB_FREE),
+// which lets the garbage collector walk the slabs.
+#define LISP_SLAB_BYTES 65536
+#define LISP_SLAB_CLASSES 8
+#define LISP_SLAB_ENV 100
+#define LISP_SLAB_FREE 101
+
+// slab counters, reported by the 'mem-stats' builtin
+static __thread long lisp_slab_hits = 0;
+static __thread long lisp_slab_misses = 0;
+static __thread long lisp_slab_live = 0;
+static __thread long lisp_slab_count = 0;
+
+// objects that don't go in a slab are malloced at their own size. vals are used through a full
+// lisp_val* but only allocated as big as their type needs, so malloc is called through a volatile
+// pointer: the compiler can't see the size, and doesn't take other types' fields as out of bounds
+static void* (* volatile lisp_malloc)(size_t) = malloc;
+
+#ifndef LISP_NO_SLAB
+
+typedef struct lisp_slab_obj {
+    int tag;
+    struct lisp_slab_obj* next;
+} lisp_slab_obj;
+
+typedef struct lisp_slab {
+    struct lisp_slab* next;
+    size_t obj_size;
+} lisp_slab;
+
+typedef struct {
+    lisp_slab* slabs;
+    lisp_slab_obj* free;
+    char* next;
+    char* end;
+} lisp_slab_class;
+
+static __thread lisp_slab_class lisp_slab_classes[LISP_SLAB_CLASSES];
+
+static inline size_t lisp_slab_class_of(size_t size) {
+    if (size < sizeof(lisp_slab_obj)) { size = sizeof(lisp_slab_obj); }
+    return (size + 7) / 8 - 1;
+}
+
+#endif
+
+// allocate an object. a hit reuses a freed object, a miss carves a new one (or mallocs it)
+void* lisp_slab_alloc(size_t size) {
+    lisp_slab_live++;
+    void* temp = lisp_region_alloc(size);
+    if (temp) { return temp; }
+#ifdef LISP_NO_SLAB
+    lisp_slab_misses++;
+    return lisp_malloc(size);
+#else
+    size_t c = lisp_slab_class_of(size);
+    if (c >= LISP_SLAB_CLASSES) {
+        lisp_slab_misses++;
+        return lisp_malloc(size);
+    }
+    lisp_slab_class* sc = &lisp_slab_classes[c];
+    if (sc->free) {
+        lisp_slab_hits++;
+        lisp_slab_obj* obj = sc->free;
+        sc->free = obj->next;
+        return obj;
+    }
+    lisp_slab_misses++;
+    size_t obj_size = (c + 1) * 8;
+    if (sc->next == NULL || (size_t) (sc->end - sc->next) < obj_size) {
+        lisp_slab* slab = malloc(LISP_SLAB_BYTES);
+        slab->obj_size = obj_size;
+        slab->next = sc->slabs;
+        sc->slabs = slab;
+        sc->next = (char*) (slab + 1);
+        sc->end = (char*) slab + LISP_SLAB_BYTES;
+        lisp_slab_count++;
+    }
+    void* obj = sc->next;
+    sc->next += obj_size;
+    return obj;
+#endif
+}
+
+// give an object back to the free list of its size class
+void lisp_slab_free(void* p, size_t size) {
+    lisp_slab_live--;
+    if (lisp_region_contains(p)) { return; }
+#ifdef LISP_NO_SLAB
+    free(p);
+#else
+    size_t c = lisp_slab_class_of(size);
+    if (c >= LISP_SLAB_CLASSES) {
+        free(p);
+        return;
+    }
+    lisp_slab_obj* obj = p;
+    obj->tag = LISP_SLAB_FREE;
+    obj->next = lisp_slab_classes[c].free;
+    lisp_slab_classes[c].free = obj;
+#endif
+}
+
+// allocation counters, reported by the 'mem-stats' builtin
+long lisp_val_allocs = 0;
+long lisp_val_frees = 0;
+long lisp_val_bytes = 0;
+
+// every boxed lisp val is allocated here, only as big as its type needs
+lisp_val* lisp_val_alloc(int type, size_t size) {
+    lisp_val* v = lisp_slab_alloc(size);
+    v->type = type;
+    v->refs = 1;
+    lisp_val_allocs++;
+    lisp_val_bytes += size;
+    return v;
+}
+
+// size of a boxed lisp val, depending on its type
+size_t lisp_val_size(lisp_val* v) {
+    switch (v->type) {
+        case LISP_VAL_NUM:    return LISP_VAL_SIZE(num);
+        case LISP_VAL_ERR:    return LISP_VAL_SIZE(err_args);
+        case LISP_VAL_SYMBOL: return LISP_VAL_SIZE(binds);
+        case LISP_VAL_STRING: return LISP_VAL_SIZE(str);
+        case LISP_VAL_FUNC:   return v->builtin ? LISP_VAL_SIZE(name) : LISP_VAL_SIZE(code);
+        case LISP_VAL_SEXPR:
+        case LISP_VAL_QEXPR:  return LISP_VAL_SIZE(cell_inline);
+    }
+    return sizeof(lisp_val);
+}
 
 //macro
-#define LASSERT(args, cond, err, ...) \
-  if (!(cond)) { free_lisp_val(args); return create_lv_err(err, ##__VA_ARGS__); }
+#define LASSERT(cond, code, err, ...) \
+  if (!(cond)) { return create_lv_err(code, err, ##__VA_ARGS__); }
 
 // method to create a lisp number
 lisp_val* create_lv_num(long x) {
-    lisp_val* value = malloc(sizeof(lisp_val));
-    value->type = LISP_VAL_NUM;
+    if (x >= LISP_FIXNUM_MIN && x <= LISP_FIXNUM_MAX) {
+        return (lisp_val*) (((uintptr_t) x << 1) | 1);
+    }
+    lisp_val* value = lisp_val_alloc(LISP_VAL_NUM, LISP_VAL_SIZE(num));
     value->num = x;
     return value;
 }
 
-// method to create a lisp error
-lisp_val* create_lv_err(char* msg, ...) {
-    lisp_val* value = malloc(sizeof(lisp_val));
-    value->type = LISP_VAL_ERR;
-    va_list va;
-    va_start(va, msg);
+// errors are built without formatting anything: the format and its arguments are kept, and the
+// message is only produced when the error is printed. %s arguments are borrowed, so they must
+// outlive the error (string literals and symbol names do); create_lv_err_copy takes a copy of a
+// transient string. errors with no arguments are the same every time, so each call site returns
+// one static error instead of allocating
+#define create_lv_err(code, fmt, ...) \
+  ({ static lisp_val lisp_err_static; create_lv_err_at(&lisp_err_static, code, fmt, ##__VA_ARGS__); })
+
+// the next %s or %i in an error format. %% is a literal %, and so is a % ending the format
+char* lisp_err_next_arg(char* c) {
+    while ((c = strchr(c, '%'))) {
+        if (c[1] == 's' || c[1] == 'i') { return c; }
+        c += c[1] ? 2 : 1;
+    }
+    return NULL;
+}
+
+lisp_val* create_lv_err_at(lisp_val* cache, int code, char* fmt, ...) {
+    if (cache->type == LISP_VAL_ERR) {
+        cache->refs++;
+        return cache;
+    }
 
-    value-> err = malloc(512);
-    vsnprintf(value->err, 511, msg, va);
+    int argc = 0;
+    for (char* c = lisp_err_next_arg(fmt); c; c = lisp_err_next_arg(c + 2)) { argc++; }
 
-    value->err = realloc(value->err, strlen(value->err + 1));
+    lisp_val* v = argc ? lisp_val_alloc(LISP_VAL_ERR, LISP_VAL_SIZE(err_args)) : cache;
+    v->err_code = code;
+    v->err_flags = argc ? 0 : LISP_ERR_STATIC;
+    v->err_fmt = fmt;
 
+    va_list va;
+    va_start(va, fmt);
+    int i = 0;
+    for (char* c = lisp_err_next_arg(fmt); c && i < LISP_ERR_MAX_ARGS; c = lisp_err_next_arg(c + 2)) {
+        if (c[1] == 's') { v->err_args[i++].s = va_arg(va, char*); }
+        else { v->err_args[i++].i = va_arg(va, int); }
+    }
     va_end(va);
-    return value;
+
+    if (!argc) {
+        // the static keeps one reference of its own, so it is never freed
+        v->type = LISP_VAL_ERR;
+        v->refs = 2;
+    }
+    return v;
+}
+
+// error with a single %s argument that is copied into the error
+lisp_val* create_lv_err_copy(int code, char* fmt, char* s) {
+    lisp_val* v = lisp_val_alloc(LISP_VAL_ERR, LISP_VAL_SIZE(err_args));
+    v->err_code = code;
+    v->err_flags = LISP_ERR_OWNED;
+    v->err_fmt = fmt;
+    v->err_args[0].s = malloc(strlen(s) + 1);
+    strcpy(v->err_args[0].s, s);
+    return v;
+}
+
+// write the message of an error into buf
+void lisp_err_format(lisp_val* v, char* buf, size_t size) {
+    size_t n = 0;
+    int i = 0;
+    for (const char* c = v->err_fmt; *c && n + 1 < size; c++) {
+        if (c[0] == '%' && (c[1] == 's' || c[1] == 'i')) {
+            n += c[1] == 's'
+                ? snprintf(buf + n, size - n, "%s", v->err_args[i].s)
+                : snprintf(buf + n, size - n, "%ld", v->err_args[i].i);
+            i++;
+            c++;
+        } else if (c[0] == '%' && c[1] == '%') {
+            buf[n++] = '%';
+            c++;
+        } else {
+            buf[n++] = *c;
+        }
+    }
+    buf[n < size ? n : size - 1] = '\0';
+}
+
+
+// FNV-1a hash of len bytes
+unsigned lisp_hash(char* s, size_t len) {
+    unsigned h = 2166136261u;
+    for (size_t i = 0; i < len; i++) { h = (h ^ (unsigned char) s[i]) * 16777619u; }
+    return h;
+}
+
+// symbols are interned: every name has exactly one symbol object, created the first time the name
+// is read and never freed (the intern table holds a reference to it). symbols can then be compared,
+// and used as env keys, by pointer. the table is open addressed and keyed by the name's hash
+lisp_val** lisp_intern_table = NULL;
+int lisp_intern_count = 0;
+int lisp_intern_size = 0;
+long lisp_intern_bytes = 0;
+
+// slot of the symbol named s, or of the empty slot where it belongs
+lisp_val** lisp_intern_slot(char* s) {
+    unsigned i = lisp_hash(s, strlen(s)) & (lisp_intern_size - 1);
+    while (lisp_intern_table[i] && strcmp(lisp_intern_table[i]->symbol, s) != 0) {
+        i = (i + 1) & (lisp_intern_size - 1);
+    }
+    return &lisp_intern_table[i];
+}
+
+void lisp_intern_grow() {
+    lisp_val** old = lisp_intern_table;
+    int old_size = lisp_intern_size;
+    lisp_intern_size = old_size ? old_size * 2 : 256;
+    lisp_intern_table = calloc(lisp_intern_size, sizeof(lisp_val*));
+    for (int i = 0; i < old_size; i++) {
+        if (old[i]) { *lisp_intern_slot(old[i]->symbol) = old[i]; }
+    }
+    free(old);
 }
 
-// method to create a lisp symbol
+// method to create a lisp symbol. returns a new reference to the interned symbol named s
 lisp_val* create_lv_symbol(char* s) {
-  lisp_val* v = malloc(sizeof(lisp_val));
-  v->type = LISP_VAL_SYMBOL;
-  v->symbol = malloc(strlen(s) + 1);
-  strcpy(v->symbol, s);
-  return v;
+    if (lisp_intern_count * 2 >= lisp_intern_size) { lisp_intern_grow(); }
+    lisp_val** slot = lisp_intern_slot(s);
+    if (*slot) {
+        (*slot)->refs++;
+        return *slot;
+    }
+
+    // symbols live forever, so they must not go into the region
+    int region = lisp_region_active;
+    lisp_region_active = 0;
+    lisp_val* v = lisp_val_alloc(LISP_VAL_SYMBOL, LISP_VAL_SIZE(binds));
+    lisp_region_active = region;
+    v->symbol = malloc(strlen(s) + 1);
+    strcpy(v->symbol, s);
+    v->id = lisp_intern_count++;
+    v->depth = -1;
+    v->slot = -1;
+    v->interned = v;
+    v->cache = NULL;
+    v->epoch = 0;
+    v->binds = 0;
+    lisp_intern_bytes += strlen(s) + 1;
+    *slot = v;
+
+    // one reference for the table, one for the caller
+    v->refs = 2;
+    return v;
+}
+
+// reference to symbol sym that is bound at 'slot' of the frame 'depth' levels up
+lisp_val* create_lv_symbol_ref(lisp_val* sym, int depth, int slot) {
+    lisp_val* v = lisp_val_alloc(LISP_VAL_SYMBOL, LISP_VAL_SIZE(binds));
+    v->symbol = sym->symbol;
+    v->id = sym->id;
+    v->depth = depth;
+    v->slot = slot;
+    v->interned = sym->interned;
+    v->cache = NULL;
+    v->epoch = 0;
+    v->binds = 0;
+    return v;
+}
+
+// the '&' of variadic formals and the name of the lambda builtin, interned at startup
+lisp_val* lisp_sym_rest = NULL;
+lisp_val* lisp_sym_lambda = NULL;
+
+lisp_val* builtin_if(lisp_env* e, int argc, lisp_val** argv);
+lisp_val* builtin_let(lisp_env* e, int argc, lisp_val** argv);
+lisp_val* builtin_cond(lisp_env* e, int argc, lisp_val** argv);
+lisp_val* builtin_and(lisp_env* e, int argc, lisp_val** argv);
+lisp_val* builtin_or(lisp_env* e, int argc, lisp_val** argv);
+lisp_val* builtin_while(lisp_env* e, int argc, lisp_val** argv);
+lisp_val* builtin_do(lisp_env* e, int argc, lisp_val** argv);
+lisp_val* builtin_try(lisp_env* e, int argc, lisp_val** argv);
+
+// special forms. they are builtins, but where one is called by name the compiler turns the call
+// into jumps, so that its operands are only evaluated when (and as often as) needed. 'cond' is
+// the error for a condition that isn't a number. the symbols are interned at startup
+typedef struct lisp_form {
+    char* name;
+    lisp_builtin builtin;
+    char* cond;
+    lisp_val* sym;
+} lisp_form;
+
+enum { LISP_FORM_IF, LISP_FORM_LET, LISP_FORM_COND, LISP_FORM_AND, LISP_FORM_OR, LISP_FORM_WHILE,
+       LISP_FORM_DO, LISP_FORM_BEGIN, LISP_FORM_TRY, LISP_FORM_COUNT };
+
+lisp_form lisp_forms[LISP_FORM_COUNT] = {
+    [LISP_FORM_IF] = { "if", builtin_if, "Argument 1 of 'if' must be bool" },
+    [LISP_FORM_LET] = { "let", builtin_let, NULL },
+    [LISP_FORM_COND] = { "cond", builtin_cond, "Test of 'cond' must be bool" },
+    [LISP_FORM_AND] = { "and", builtin_and, "Arguments of 'and' must be bool" },
+    [LISP_FORM_OR] = { "or", builtin_or, "Arguments of 'or' must be bool" },
+    [LISP_FORM_WHILE] = { "while", builtin_while, "Condition of 'while' must be bool" },
+    [LISP_FORM_DO] = { "do", builtin_do, NULL },
+    [LISP_FORM_BEGIN] = { "begin", builtin_do, NULL },
+    [LISP_FORM_TRY] = { "try", builtin_try, NULL },
+};
+
+// whether the count cells are {x value} pairs, with x a symbol if symbols is set
+int lisp_val_pairs(lisp_val** cells, int count, int symbols) {
+    for (int i = 0; i < count; i++) {
+        lisp_val* x = cells[i];
+        if (lisp_val_type(x) != LISP_VAL_QEXPR || x->count != 2) { return 0; }
+        if (symbols && lisp_val_type(x->cell[0]) != LISP_VAL_SYMBOL) { return 0; }
+    }
+    return 1;
+}
+
+// the special form that s-expression x calls by name, if its operands are written the way the
+// compiler handles, -1 otherwise. anything else is left to the builtin
+int lisp_form_of(lisp_val* x) {
+    if (x->count < 2 || lisp_val_type(x->cell[0]) != LISP_VAL_SYMBOL) { return -1; }
+    int f = 0;
+    while (f < LISP_FORM_COUNT && lisp_forms[f].sym != x->cell[0]->interned) { f++; }
+    int ok = 0;
+    switch (f) {
+        case LISP_FORM_IF:
+            ok = x->count == 4 && lisp_val_type(x->cell[2]) == LISP_VAL_QEXPR
+                && lisp_val_type(x->cell[3]) == LISP_VAL_QEXPR;
+            break;
+        case LISP_FORM_LET:
+            ok = x->count == 3 && lisp_val_type(x->cell[1]) == LISP_VAL_QEXPR
+                && lisp_val_type(x->cell[2]) == LISP_VAL_QEXPR
+                && lisp_val_pairs(x->cell[1]->cell, x->cell[1]->count, 1);
+            break;
+        case LISP_FORM_COND:
+            ok = lisp_val_pairs(&x->cell[1], x->count - 1, 0);
+            break;
+        case LISP_FORM_WHILE:
+            ok = x->count == 3 && lisp_val_type(x->cell[1]) == LISP_VAL_QEXPR
+                && lisp_val_type(x->cell[2]) == LISP_VAL_QEXPR;
+            break;
+        case LISP_FORM_TRY:
+            ok = x->count == 3 && lisp_val_type(x->cell[1]) == LISP_VAL_QEXPR;
+            break;
+        case LISP_FORM_AND:
+        case LISP_FORM_OR:
+        case LISP_FORM_DO:
+        case LISP_FORM_BEGIN:
+            ok = 1;
+            break;
+    }
+    return ok ? f : -1;
+}
+
+// empty expression of the given type, its cells start out inline
+lisp_val* create_lv_expr(int type) {
+    lisp_val* v = lisp_val_alloc(type, LISP_VAL_SIZE(cell_inline));
+    v->count = 0;
+    v->cap = LISP_EXPR_INLINE;
+    v->cell = v->cell_inline;
+    return v;
 }
 
 // method to create a lisp S-Expression
 lisp_val* create_lv_sexpr() {
-  lisp_val* v = malloc(sizeof(lisp_val));
-  v->type = LISP_VAL_SEXPR;
-  v->count = 0;
-  v->cell = NULL;
-  return v;
+    return create_lv_expr(LISP_VAL_SEXPR);
 }
 
 // method to create a lisp Q-Expression
 lisp_val* create_lv_qexpr() {
-    lisp_val* v = malloc(sizeof(lisp_val));
-    v->type = LISP_VAL_QEXPR;
-    v->count = 0;
-    v->cell = NULL;
-    return v;
+    return create_lv_expr(LISP_VAL_QEXPR);
+}
+
+// make room for at least n cells in an unshared expression. capacity at least doubles,
+// so appending is amortized O(1)
+void lisp_val_reserve(lisp_val* v, int n) {
+    if (n <= v->cap) { return; }
+    int cap = v->cap * 2 > n ? v->cap * 2 : n;
+    if (v->cell == v->cell_inline) {
+        v->cell = malloc(sizeof(lisp_val*) * cap);
+        memcpy(v->cell, v->cell_inline, sizeof(lisp_val*) * v->count);
+    } else {
+        v->cell = realloc(v->cell, sizeof(lisp_val*) * cap);
+    }
+    v->cap = cap;
+}
+
+// free the cell array of an expression, unless it is inline
+static inline void lisp_val_free_cells(lisp_val* v) {
+    if (v->cell != v->cell_inline) { free(v->cell); }
 }
 
 //method to create a lisp builtin function
-lisp_val* create_lv_func(lisp_builtin func) {
-    lisp_val* v = malloc(sizeof(lisp_val));
-    v->type = LISP_VAL_FUNC;
+lisp_val* create_lv_func(lisp_builtin func, char* name, int min_args, int max_args) {
+    lisp_val* v = lisp_val_alloc(LISP_VAL_FUNC, LISP_VAL_SIZE(name));
     v->builtin = func;
+    v->min_args = min_args;
+    v->max_args = max_args;
+    v->name = name;
     return v;
 }
 
 //method to create a lisp env
 lisp_env* create_lisp_env() {
-    lisp_env* e = malloc(sizeof(lisp_env));
+    lisp_env* e = lisp_slab_alloc(sizeof(lisp_env));
+    e->type = LISP_SLAB_ENV;
+    e->refs = 1;
+    e->temp = lisp_region_active;
     e->count = 0;
+    e->cap = 0;
     e->symbols = NULL;
     e->lisp_vals = NULL;
+    e->index = NULL;
+    e->index_size = 0;
     e->parent = NULL;
     return e;
 }
 
+// a 'try' in some code: an error raised by the instructions from start up to end goes to the
+// handler, with the values and 'let' frames the code had at the start
+typedef struct lisp_try {
+    int start;
+    int end;
+    int handler;
+    int depth;
+    int lets;
+} lisp_try;
+
+// bytecode of a lambda body, see lisp_compile. the constants are borrowed from the body, which
+// the lambda keeps alive, so code owns no lisp vals. copies of a lambda share its code
+typedef struct lisp_code {
+    int refs;
+    int count;
+    int cap;
+    int* ops;
+    int const_count;
+    int const_cap;
+    lisp_val** consts;
+    // most values the code has on the stack at once
+    int stack;
+    // number of formals, -1 if they are variadic
+    int arity;
+    // code of a lambda in the region, which is dropped with it instead of being freed
+    int temp;
+    struct lisp_code* next_temp;
+    // address of the handler of each instruction, see lisp_vm_exec
+    void** handlers;
+    // calls so far, -1 once the JIT gave up on the code, and its native code once it has it
+    int calls;
+    struct lisp_jit* jit;
+    // the try_count 'try's in the code, each after those inside it
+    lisp_try* tries;
+    int try_count;
+} lisp_code;
+
+// the code of the lambdas in the region
+lisp_code* lisp_region_codes = NULL;
+
+lisp_code* lisp_code_copy(lisp_code* c) {
+    if (c) { c->refs++; }
+    return c;
+}
+
+void lisp_code_free(lisp_code* c) {
+    if (c == NULL || c->temp || --c->refs > 0) { return; }
+    free(c->ops);
+    free(c->consts);
+    free(c->handlers);
+    free(c->jit);
+    free(c->tries);
+    free(c);
+}
+
+// free the code of the lambdas in the region, once it is dropped
+void lisp_code_drop_region() {
+    while (lisp_region_codes) {
+        lisp_code* c = lisp_region_codes;
+        lisp_region_codes = c->next_temp;
+        c->temp = 0;
+        c->refs = 1;
+        lisp_code_free(c);
+    }
+}
+
 //method to create lisp lambda
 lisp_val* create_lv_lambda(lisp_val* formals, lisp_val* body) {
-    lisp_val* v = malloc(sizeof(lisp_val));
-    v->type = LISP_VAL_FUNC;
+    lisp_val* v = lisp_val_alloc(LISP_VAL_FUNC, LISP_VAL_SIZE(code));
     v->builtin = NULL;
     v->env = create_lisp_env();
     v->formals = formals;
     v->body = body;
+    v->code = NULL;
+    return v;
+}
+
+// bytes of a lisp string. they are immutable once created, so lisp vals share them by reference
+// count and copying a string never copies its bytes. strings carry their own length (they may
+// contain NULs) and a hash, so most unequal strings are told apart without comparing bytes
+typedef struct lisp_str {
+    int refs;
+    int len;
+    unsigned hash;
+    // len bytes, plus a NUL so the bytes can be passed to C functions
+    char bytes[];
+} lisp_str;
+
+lisp_str* lisp_str_new(char* s, int len) {
+    lisp_str* str = malloc(sizeof(lisp_str) + len + 1);
+    str->refs = 1;
+    str->len = len;
+    str->hash = lisp_hash(s, len);
+    memcpy(str->bytes, s, len);
+    str->bytes[len] = '\0';
+    return str;
+}
+
+void lisp_str_free(lisp_str* str) {
+    if (--str->refs == 0) { free(str); }
+}
+
+//method to create lisp string from the first len bytes of s
+lisp_val* create_lv_string_len(char* s, int len) {
+    lisp_val* v = lisp_val_alloc(LISP_VAL_STRING, LISP_VAL_SIZE(str));
+    v->str = lisp_str_new(s, len);
     return v;
 }
 
 //method to create lisp string
 lisp_val* create_lv_string(char* string) {
-    lisp_val* v = malloc(sizeof(lisp_val));
-    v->type = LISP_VAL_STRING;
-    v->string = malloc(strlen(string) + 1);
-    strcpy(v->string, string);
-    return v;
+    return create_lv_string_len(string, strlen(string));
 }
 
 void free_lisp_val(lisp_val* v);
 
 // method to free lisp env
 void free_lisp_env(lisp_env* e) {
+    // still shared with other functions
+    if (--e->refs > 0) { return; }
+
     for(int i = 0; i < e->count; i++) {
-        free(e->symbols[i]);
+        e->symbols[i]->binds--;
         free_lisp_val(e->lisp_vals[i]);
     }
     free(e->symbols);
-    free(e->lisp_vals);
-    free(e);
+    free(e->index);
+    lisp_slab_free(e, sizeof(lisp_env));
 }
 
 lisp_val* lisp_val_copy(lisp_val* v);
 
+// the env of the top-level, at the root of every chain of frames. the epoch changes whenever
+// one of its bindings does, which invalidates all cached global lookups
+lisp_env* lisp_global_env = NULL;
+long lisp_global_epoch = 1;
+
+// index slot of symbol k, or of the empty slot where it belongs
+static inline int lisp_env_slot(lisp_env* e, lisp_val* k) {
+    unsigned i = ((unsigned) k->id * 2654435769u) & (e->index_size - 1);
+    while (e->index[i] && e->symbols[e->index[i] - 1] != k) {
+        i = (i + 1) & (e->index_size - 1);
+    }
+    return i;
+}
+
+// (re)build the index of a large frame, sized for at least twice its entries
+void lisp_env_reindex(lisp_env* e) {
+    if (e->count <= LISP_ENV_LINEAR) { return; }
+    int size = e->index_size ? e->index_size : 32;
+    while (size < e->count * 2) { size *= 2; }
+    free(e->index);
+    e->index = calloc(size, sizeof(int));
+    e->index_size = size;
+    for (int i = 0; i < e->count; i++) {
+        e->index[lisp_env_slot(e, e->symbols[i])] = i + 1;
+    }
+}
+
+// entry of symbol k in this frame only, -1 if it has none
+static inline int lisp_env_find(lisp_env* e, lisp_val* k) {
+    if (e->index) {
+        return e->index[lisp_env_slot(e, k)] - 1;
+    }
+    for (int i = 0; i < e->count; i++) {
+        if (e->symbols[i] == k) { return i; }
+    }
+    return -1;
+}
+
+// allocate room for cap entries. any old ones are left for the caller to move and free
+void lisp_env_alloc_entries(lisp_env* e, int cap) {
+    e->cap = cap;
+    e->symbols = malloc(sizeof(lisp_val*) * cap * 2);
+    e->lisp_vals = e->symbols + cap;
+}
+
 // get lisp env value
 lisp_val* lisp_env_get(lisp_env* e, lisp_val* k) {
 
-    // iterate over all items in env, return copy of matching record
-    for (int i = 0; i < e->count; i++) {
-        if(strcmp(e->symbols[i], k->symbol) == 0) {
+    // a resolved reference is found without searching its frame, if the frames are laid out as
+    // the lambda expected: the binding is at (depth, slot), and no closer frame shadows it
+    if (k->slot >= 0) {
+        lisp_env* f = e;
+        int depth = k->depth;
+        while (f && depth > 0 && lisp_env_find(f, k->interned) < 0) {
+            f = f->parent;
+            depth--;
+        }
+        if (f && depth == 0 && k->slot < f->count && f->symbols[k->slot] == k->interned) {
+            return lisp_val_copy(f->lisp_vals[k->slot]);
+        }
+    }
+
+    // a global reference caches its binding. it can only refer to a global if no other env binds
+    // the name, in which case the global env doesn't need to be searched for at all
+    if (k != k->interned && k->slot < 0 && k->interned->binds == 0) {
+        if (k->epoch == lisp_global_epoch) {
+            return lisp_val_copy(k->cache);
+        }
+        int i = lisp_env_find(lisp_global_env, k->interned);
+        if (i >= 0) {
+            k->cache = lisp_global_env->lisp_vals[i];
+            k->epoch = lisp_global_epoch;
+            return lisp_val_copy(k->cache);
+        }
+    }
+    k = k->interned;
+
+    // search the frames from innermost to outermost, return copy of matching record
+    for (; e; e = e->parent) {
+        int i = lisp_env_find(e, k);
+        if (i >= 0) {
             return lisp_val_copy(e->lisp_vals[i]);
         }
     }
-    // does parent exist? if so use it
-    if(e->parent) {
-        return lisp_env_get(e->parent, k);
+    return create_lv_err(ERROR_UNBOUND, "Symbol '%s' does not exist!", k->symbol);
+}
+
+lisp_val* lisp_val_promote(lisp_val* v);
+
+// add a binding for k, which e must not bind yet, without searching. takes ownership of v
+void lisp_env_bind(lisp_env* e, lisp_val* k, lisp_val* v) {
+    // make space for new entry (doubling) and copy in
+    if (e->count == e->cap) {
+        lisp_val** symbols = e->symbols;
+        lisp_val** lisp_vals = e->lisp_vals;
+        lisp_env_alloc_entries(e, e->cap ? e->cap * 2 : 4);
+        if (symbols) {
+            memcpy(e->symbols, symbols, sizeof(lisp_val*) * e->count);
+            memcpy(e->lisp_vals, lisp_vals, sizeof(lisp_val*) * e->count);
+            free(symbols);
+        }
+    }
+
+    // interned symbols are never freed, so the env doesn't need a reference to its keys
+    e->lisp_vals[e->count] = v;
+    e->symbols[e->count] = k;
+    e->count++;
+    if (e != lisp_global_env) {
+        k->binds++;
+    }
+
+    if (e->index && e->count * 2 <= e->index_size) {
+        e->index[lisp_env_slot(e, k)] = e->count;
+    } else {
+        lisp_env_reindex(e);
     }
-    return create_lv_err("Symbol '%s' does not exist!", k->symbol);
 }
 
 // put lisp env value
 void lisp_env_put(lisp_env* e, lisp_val* k, lisp_val* v) {
-    // see if already exists
-    for (int i = 0; i < e->count; i++) {
-        if(strcmp(e->symbols[i], k->symbol) == 0) {
-            free_lisp_val(e->lisp_vals[i]);
-            e->lisp_vals[i] = lisp_val_copy(v);
-            return;
-        }
+    // an env from before the current form outlives it, so the value can't stay in the region
+    v = e->temp || !lisp_region_active ? lisp_val_copy(v) : lisp_val_promote(v);
+    k = k->interned;
+    if (e == lisp_global_env) {
+        lisp_global_epoch++;
     }
 
-    // didn't find already existing, so allocate space for new entry and copy in
-    e->count++;
-    e->lisp_vals = realloc(e->lisp_vals, sizeof(lisp_val*) * e->count);
-    e->symbols = realloc(e->symbols, sizeof(char*) * e->count);
+    // see if already exists
+    int i = lisp_env_find(e, k);
+    if (i >= 0) {
+        free_lisp_val(e->lisp_vals[i]);
+        e->lisp_vals[i] = v;
+        return;
+    }
 
-    e->lisp_vals[e->count - 1] = lisp_val_copy(v);
-    e->symbols[e->count - 1] = malloc(strlen(k->symbol) + 1);
-    strcpy(e->symbols[e->count - 1], k->symbol);
+    // didn't find already existing, so add it
+    lisp_env_bind(e, k, v);
 }
 
 // define variable globally
@@ -201,38 +953,51 @@ lisp_val* lisp_val_read_num(mpc_ast_t* t) {
     int err = 0;
     long x = strtol(t->contents, NULL, 10);
     return err != ERANGE ?
-        create_lv_num(x) : create_lv_err("Invalid number %s!", t->contents);
+        create_lv_num(x) : create_lv_err_copy(ERROR_BAD_NUM, "Invalid number %s!", t->contents);
 }
 
+lisp_val* lisp_val_own(lisp_val* v);
+
 // append that lisp val to this lisp val. 
 lisp_val* lisp_val_add(lisp_val* orig, lisp_val* add) {
-    orig->count++;
-    // adding to array, thus we have to reallocate memory to add more
-    orig->cell = realloc(orig->cell, sizeof(lisp_val*) * orig->count);
-    orig->cell[orig->count - 1] = add;
+    orig = lisp_val_own(orig);
+    lisp_val_reserve(orig, orig->count + 1);
+    orig->cell[orig->count++] = add;
     return orig;
 }
 
 //append that lisp val to this lisp val, but at the head
 lisp_val* lisp_val_add_at_head(lisp_val* orig, lisp_val* add) {
-    orig->count++;
-    // adding to array, thus we have to reallocate memory to add more
-    orig->cell = realloc(orig->cell, sizeof(lisp_val*) * orig->count);
+    orig = lisp_val_own(orig);
+    lisp_val_reserve(orig, orig->count + 1);
     // move all array elems up by 1
-    for (int i = orig->count - 1; i > 0; i--) {
-        orig->cell[i] = orig->cell[i - 1];
-    }
+    memmove(&orig->cell[1], &orig->cell[0], sizeof(lisp_val*) * orig->count);
     orig->cell[0] = add;
+    orig->count++;
     return orig;
 }
 
+// C escapes and the characters they stand for. '\\0' makes a NUL, which strings may contain
+static const char lisp_escape_codes[] = "abfnrtv\\'\"0";
+static const char lisp_escape_chars[] = "\a\b\f\n\r\t\v\\'\"";
+
 // read lisp val string
 lisp_val* lisp_val_read_string(mpc_ast_t* t) {
-    t->contents[strlen(t->contents)-1] = '\0';
-    char* unescaped = malloc(strlen(t->contents+1)+1);
-    strcpy(unescaped, t->contents+1);
-    unescaped = mpcf_unescape(unescaped);
-    lisp_val* str = create_lv_string(unescaped);
+    // skip the quotes
+    char* s = t->contents + 1;
+    int len = strlen(s) - 1;
+    char* unescaped = malloc(len + 1);
+    int n = 0;
+    for (int i = 0; i < len; i++) {
+        char* code = s[i] == '\\' && i + 1 < len ? strchr(lisp_escape_codes, s[i + 1]) : NULL;
+        if (code && *code) {
+            unescaped[n++] = lisp_escape_chars[code - lisp_escape_codes];
+            i++;
+        } else {
+            unescaped[n++] = s[i];
+        }
+    }
+    lisp_val* str = create_lv_string_len(unescaped, n);
     free(unescaped);
     return str;
 }
@@ -251,6 +1016,8 @@ lisp_val* lisp_val_read(mpc_ast_t* t) {
     if (strcmp(t->tag, ">") == 0) { x = create_lv_sexpr(); }
     if (strstr(t->tag, "sexpr"))  { x = create_lv_sexpr(); }
     if (strstr(t->tag, "qexpr"))  { x = create_lv_qexpr(); }
+    // at most one cell per child, so the cells are only allocated once
+    lisp_val_reserve(x, t->children_num);
     // the lisp val is a s-expression. add the children to the lisp val, then return
     for (int i = 0; i < t->children_num; i++) {
         if (strstr(t->children[i]->tag, "comment")) { continue; }
@@ -266,87 +1033,152 @@ lisp_val* lisp_val_read(mpc_ast_t* t) {
 
 void lisp_val_print(lisp_val* v);
 
-// print lisp val expression
-void lisp_val_expr_print(lisp_val* v, char open, char close) {
-  putchar(open);
-  for (int i = 0; i < v->count; i++) {
-
-    lisp_val_print(v->cell[i]);
-
-    if (i != (v->count-1)) {
-      putchar(' ');
-    }
-  }
-  putchar(close);
-}
-
 // print lisp val string
 void print_lisp_val_string(lisp_val* v) {
-    char* mpc_escaped_string = malloc(strlen(v->string) + 1);
-    strcpy(mpc_escaped_string, v->string);
-    mpc_escaped_string = mpcf_escape(mpc_escaped_string);
-    printf("\"%s\"", mpc_escaped_string);
-    free(mpc_escaped_string);
+    putchar('"');
+    for (int i = 0; i < v->str->len; i++) {
+        char c = v->str->bytes[i];
+        // lisp_escape_chars ends in a NUL, so NULs are found (and escaped) too
+        char* escape = memchr(lisp_escape_chars, c, sizeof(lisp_escape_chars));
+        if (escape) {
+            putchar('\\');
+            putchar(lisp_escape_codes[escape - lisp_escape_chars]);
+        } else {
+            putchar(c);
+        }
+    }
+    putchar('"');
 }
 
-// print lisp value depending on its contents
+// an expression being printed, and the next of its cells to print. a NULL expression stands for
+// the ')' that closes a lambda once its body is printed
+typedef struct lisp_print_item {
+    lisp_val* v;
+    int i;
+} lisp_print_item;
+
+// print lisp value depending on its contents. the expressions it is nested in are kept on an
+// explicit stack rather than the C stack, so values of any depth can be printed
 void lisp_val_print(lisp_val* v) {
-  switch (v->type) {
-    case LISP_VAL_NUM:   printf("%li", v->num); break;
-    case LISP_VAL_STRING: print_lisp_val_string(v); break;
-    case LISP_VAL_FUNC: 
-        if(v->builtin) {
-        printf("<builtin>");
+    lisp_print_item items_inline[16];
+    lisp_print_item* items = items_inline;
+    int count = 0;
+    int size = 16;
+
+    while (v) {
+        if (count + 2 > size) {
+            size *= 2;
+            items = items == items_inline
+                ? memcpy(malloc(sizeof(lisp_print_item) * size), items_inline, sizeof(items_inline))
+                : realloc(items, sizeof(lisp_print_item) * size);
         }
-        else {
-            printf("(\\ "); 
-            lisp_val_print(v->formals);
-            printf(" ");
-            lisp_val_print(v->body);
-            printf(")");
+
+        // print v, or for an expression just its opening bracket
+        switch (lisp_val_type(v)) {
+            case LISP_VAL_NUM:    printf("%li", lisp_val_num(v)); break;
+            case LISP_VAL_STRING: print_lisp_val_string(v); break;
+            case LISP_VAL_SYMBOL: printf("%s", v->symbol); break;
+            case LISP_VAL_ERR: {
+                char msg[512];
+                lisp_err_format(v, msg, sizeof(msg));
+                printf("Error: %s", msg);
+                break;
+            }
+            case LISP_VAL_FUNC:
+                if (v->builtin) {
+                    printf("<builtin>");
+                    break;
+                }
+                // formals already bound by a partial application are left out
+                printf("(\\ {");
+                for (int i = v->env->count; i < v->formals->count; i++) {
+                    lisp_val_print(v->formals->cell[i]);
+                    if (i != v->formals->count - 1) {
+                        putchar(' ');
+                    }
+                }
+                printf("} ");
+                items[count++] = (lisp_print_item) { NULL, 0 };
+                v = v->body;
+                continue;
+            case LISP_VAL_SEXPR:
+            case LISP_VAL_QEXPR:
+                putchar(v->type == LISP_VAL_SEXPR ? '(' : '{');
+                items[count++] = (lisp_print_item) { v, 0 };
+                break;
         }
-        break;
-    case LISP_VAL_ERR:   printf("Error: %s", v->err); break;
-    case LISP_VAL_SYMBOL:printf("%s", v->symbol); break;
-    case LISP_VAL_SEXPR: lisp_val_expr_print(v, '(', ')'); break;
-    case LISP_VAL_QEXPR: lisp_val_expr_print(v, '{', '}'); break;
-  }
+
+        // go on with the next cell of the innermost expression, closing those that are done
+        v = NULL;
+        while (count > 0 && v == NULL) {
+            lisp_print_item* top = &items[count - 1];
+            if (top->v && top->i < top->v->count) {
+                if (top->i > 0) { putchar(' '); }
+                v = top->v->cell[top->i++];
+                continue;
+            }
+            putchar(top->v == NULL || top->v->type == LISP_VAL_SEXPR ? ')' : '}');
+            count--;
+        }
+    }
+    if (items != items_inline) { free(items); }
 }
 
 
+// children of freed lisp vals waiting to be released. free_lisp_val works through them in a loop
+// instead of recursing, so values of any depth can be freed. the frees nested in it (through envs)
+// use the part above where they started
+lisp_val** lisp_free_pending = NULL;
+int lisp_free_pending_count = 0;
+int lisp_free_pending_size = 0;
+
 // lisp vals are malloc'ed, so ensure that they are fully freed from the heap
 void free_lisp_val(lisp_val* v) {
-
-    switch (v->type) {
-
-        // if num or func, stack only so no free necessary
-        case LISP_VAL_NUM: break;
-        case LISP_VAL_STRING: free(v->string); break;
-        case LISP_VAL_FUNC: 
-            if(!v->builtin) {
-                free_lisp_env(v->env);
-                free_lisp_val(v->formals);
-                free_lisp_val(v->body);
-            } 
-            break;
-        
-        // if err/symbol, free the error or symbol
-        case LISP_VAL_ERR: free(v->err); break;
-        case LISP_VAL_SYMBOL: free(v->symbol); break;
-
-        // if s-expression or q-expression, free its children
-        case LISP_VAL_QEXPR:
-        case LISP_VAL_SEXPR:
-            for (int i = 0; i < v->count; i++) {
-                free_lisp_val(v->cell[i]);
+    int base = lisp_free_pending_count;
+
+    for (;;) {
+        // unboxed numbers own no memory, and shared vals are still referenced elsewhere
+        if (!lisp_val_is_fixnum(v) && --v->refs == 0) {
+            switch (lisp_val_type(v)) {
+
+                // if num or func, stack only so no free necessary
+                case LISP_VAL_NUM: break;
+                case LISP_VAL_STRING: lisp_str_free(v->str); break;
+                case LISP_VAL_FUNC: 
+                    if(!v->builtin) {
+                        free_lisp_env(v->env);
+                        free_lisp_val(v->formals);
+                        free_lisp_val(v->body);
+                        lisp_code_free(v->code);
+                    } 
+                    break;
+
+                // if err, free the error. symbols are owned by the intern table
+                case LISP_VAL_ERR: if (v->err_flags & LISP_ERR_OWNED) { free(v->err_args[0].s); } break;
+
+                // if s-expression or q-expression, its children are released next
+                case LISP_VAL_QEXPR:
+                case LISP_VAL_SEXPR:
+                    if (lisp_free_pending_count + v->count > lisp_free_pending_size) {
+                        lisp_free_pending_size = (lisp_free_pending_count + v->count) * 2;
+                        lisp_free_pending = realloc(lisp_free_pending,
+                            sizeof(lisp_val*) * lisp_free_pending_size);
+                    }
+                    for (int i = 0; i < v->count; i++) {
+                        lisp_free_pending[lisp_free_pending_count++] = v->cell[i];
+                    }
+                    lisp_val_free_cells(v);
+                    break;
             }
-            free(v->cell);
-            break;
-        
-
+            // now that everything necessary is freed, free the actual lisp val on heap
+            lisp_val_frees++;
+            size_t size = lisp_val_size(v);
+            lisp_val_bytes -= size;
+            lisp_slab_free(v, size);
+        }
+        if (lisp_free_pending_count == base) { return; }
+        v = lisp_free_pending[--lisp_free_pending_count];
     }
-    // now that everything necessary is freed, free the actual lisp val on heap
-    free(v);
 }
 
 // extract input from user
@@ -356,46 +1188,73 @@ char* readline(char* prompt) {
   size_t len = 0;
   ssize_t ilen;
   ilen = getline(&line, &len, stdin);
+  if (ilen == -1) {
+      free(line);
+      return NULL;
+  }
   return line;
 }
 
-lisp_env* lisp_env_copy(lisp_env* e); 
 
-// copy lisp val
+// copy lisp val. values don't change while they are shared, so a copy is just one more reference
 lisp_val* lisp_val_copy(lisp_val* v) {
 
-  lisp_val* x = malloc(sizeof(lisp_val));
-  x->type = v->type;
+  // unboxed numbers are copied by value
+  if (!lisp_val_is_fixnum(v)) { v->refs++; }
+  return v;
+}
+
+// make a new, unshared lisp val with the same contents. children are shared, not cloned
+lisp_val* lisp_val_clone(lisp_val* v) {
+
+  // there is only ever one of each symbol
+  if (lisp_val_type(v) == LISP_VAL_SYMBOL && v->interned == v) { return lisp_val_copy(v); }
+  if (lisp_val_type(v) == LISP_VAL_SYMBOL) { return create_lv_symbol_ref(v, v->depth, v->slot); }
 
-  switch (v->type) {
+  lisp_val* x = lisp_val_alloc(v->type, lisp_val_size(v));
+
+  switch (lisp_val_type(v)) {
 
     case LISP_VAL_FUNC: 
         if(v->builtin) {
             x->builtin = v->builtin;
+            x->min_args = v->min_args;
+            x->max_args = v->max_args;
+            x->name = v->name;
         }
         else {
             x->builtin = NULL;
-            x->env = lisp_env_copy(v->env);
+            // the env is shared, and only copied once the clone binds something in it
+            x->env = v->env;
+            x->env->refs++;
             x->formals = lisp_val_copy(v->formals);
             x->body = lisp_val_copy(v->body);
+            x->code = lisp_code_copy(v->code);
         }
         break;
 
     case LISP_VAL_NUM: x->num = v->num; break;
-    case LISP_VAL_STRING: x->string = malloc(strlen(v->string) + 1); strcpy(x->string, v->string); break;
+    case LISP_VAL_STRING: x->str = v->str; x->str->refs++; break;
 
     case LISP_VAL_ERR:
-      x->err = malloc(strlen(v->err) + 1);
-      strcpy(x->err, v->err); break;
+      x->err_code = v->err_code;
+      x->err_flags = v->err_flags & ~LISP_ERR_STATIC;
+      x->err_fmt = v->err_fmt;
+      memcpy(x->err_args, v->err_args, sizeof(x->err_args));
+      if (x->err_flags & LISP_ERR_OWNED) {
+          x->err_args[0].s = malloc(strlen(v->err_args[0].s) + 1);
+          strcpy(x->err_args[0].s, v->err_args[0].s);
+      }
+      break;
 
-    case LISP_VAL_SYMBOL:
-      x->symbol = malloc(strlen(v->symbol) + 1);
-      strcpy(x->symbol, v->symbol); break;
 
     case LISP_VAL_SEXPR:
     case LISP_VAL_QEXPR:
+      x->count = 0;
+      x->cap = LISP_EXPR_INLINE;
+      x->cell = x->cell_inline;
+      lisp_val_reserve(x, v->count);
       x->count = v->count;
-      x->cell = malloc(sizeof(lisp_val*) * x->count);
       for (int i = 0; i < x->count; i++) {
         x->cell[i] = lisp_val_copy(v->cell[i]);
       }
@@ -405,490 +1264,2437 @@ lisp_val* lisp_val_copy(lisp_val* v) {
   return x;
 }
 
+// copy on write: take ownership of v and return a version of it that is safe to mutate.
+// objects from before the current form are copied as well, so they never point into the region
+lisp_val* lisp_val_own(lisp_val* v) {
+    if (lisp_val_is_fixnum(v)) { return v; }
+    if (v->refs == 1 && (!lisp_region_active || lisp_region_overflowed || lisp_region_contains(v))) {
+        return v;
+    }
+    lisp_val* x = lisp_val_clone(v);
+    free_lisp_val(v);
+    return x;
+}
+
+// a value being promoted whose parts are promoted one at a time. for an expression the parts are
+// its cells, for a lambda its formals, its body and then the values of its env
+typedef struct lisp_promote_item {
+    lisp_val* v;
+    // the copy out of the region, and the copy of a lambda's env, once made
+    lisp_val* x;
+    lisp_env* env;
+    // the promoted formals and body of a lambda
+    lisp_val* formals;
+    lisp_val* body;
+    // next part to promote
+    int i;
+    int moved;
+} lisp_promote_item;
+
+// promote v if it has no parts to promote, else NULL
+lisp_val* lisp_val_promote_leaf(lisp_val* v) {
+    if (lisp_val_is_fixnum(v)) { return v; }
+    int moved = lisp_region_contains(v);
+    if (!moved && !lisp_region_overflowed) { return lisp_val_copy(v); }
+    if (v->type == LISP_VAL_SEXPR || v->type == LISP_VAL_QEXPR) { return NULL; }
+    if (v->type == LISP_VAL_FUNC && !v->builtin) { return NULL; }
+    if (!moved) { return lisp_val_copy(v); }
+    lisp_region_active = 0;
+    lisp_val* x = lisp_val_clone(v);
+    lisp_region_active = 1;
+    return x;
+}
+
+// the next part of item to promote, or NULL once they all are
+lisp_val* lisp_promote_next(lisp_promote_item* item) {
+    lisp_val* v = item->v;
+    if (v->type != LISP_VAL_FUNC) { return item->i < v->count ? v->cell[item->i++] : NULL; }
+    if (item->i == 0) { item->i++; return v->formals; }
+    if (item->i == 1) { item->i++; return v->body; }
+    if (item->env == NULL) {
+        if (!item->moved && !v->env->temp && item->formals == v->formals && item->body == v->body) {
+            return NULL;
+        }
+        lisp_region_active = 0;
+        lisp_val* x = lisp_val_alloc(LISP_VAL_FUNC, lisp_val_size(v));
+        lisp_env* e = create_lisp_env();
+        lisp_region_active = 1;
+        x->builtin = NULL;
+        x->formals = item->formals;
+        x->body = item->body;
+        // code borrows from the body, so it only carries over if the body did
+        x->code = x->body == v->body && v->code && !v->code->temp ? lisp_code_copy(v->code) : NULL;
+        e->parent = v->env->parent;
+        e->count = v->env->count;
+        lisp_env_alloc_entries(e, e->count);
+        for (int i = 0; i < e->count; i++) {
+            e->symbols[i] = v->env->symbols[i];
+            e->symbols[i]->binds++;
+        }
+        item->x = x;
+        item->env = e;
+    }
+    return item->i - 2 < v->env->count ? v->env->lisp_vals[item->i++ - 2] : NULL;
+}
+
+// the promoted value of item, once all of its parts are
+lisp_val* lisp_promote_finish(lisp_promote_item* item) {
+    lisp_val* v = item->v;
+    if (v->type != LISP_VAL_FUNC) {
+        item->x->count = v->count;
+        if (item->moved) { return item->x; }
+        free_lisp_val(item->x);
+        return lisp_val_copy(v);
+    }
+    if (item->env == NULL) {
+        free_lisp_val(item->formals);
+        free_lisp_val(item->body);
+        return lisp_val_copy(v);
+    }
+    lisp_env_reindex(item->env);
+    item->x->env = item->env;
+    return item->x;
+}
+
+// return v without any references into the region, copying the parts that are in it to the slabs.
+// objects outside the region only point into it if they were allocated after it overflowed.
+// values nest arbitrarily deep, so the values being promoted are kept on a stack of their own
+lisp_val* lisp_val_promote(lisp_val* v) {
+    lisp_promote_item inline_items[16];
+    lisp_promote_item* items = inline_items;
+    int size = 16;
+    int n = 0;
+
+    for (;;) {
+        lisp_val* x = lisp_val_promote_leaf(v);
+        if (x == NULL) {
+            if (n == size) {
+                size *= 2;
+                items = items == inline_items
+                    ? memcpy(malloc(sizeof(lisp_promote_item) * size), inline_items, sizeof(inline_items))
+                    : realloc(items, sizeof(lisp_promote_item) * size);
+            }
+            items[n++] = (lisp_promote_item) { v, NULL, NULL, NULL, NULL, 0, lisp_region_contains(v) };
+            if (v->type != LISP_VAL_FUNC) {
+                lisp_region_active = 0;
+                items[n - 1].x = create_lv_expr(v->type);
+                lisp_val_reserve(items[n - 1].x, v->count);
+                lisp_region_active = 1;
+            }
+        }
+
+        // hand each promoted value to the item it is a part of, until one has another part to promote
+        for (;;) {
+            if (x) {
+                if (n == 0) {
+                    if (items != inline_items) { free(items); }
+                    return x;
+                }
+                lisp_promote_item* item = &items[n - 1];
+                int part = item->i - 1;
+                if (item->v->type != LISP_VAL_FUNC) {
+                    item->x->cell[part] = x;
+                    item->moved |= x != item->v->cell[part];
+                } else if (part == 0) {
+                    item->formals = x;
+                } else if (part == 1) {
+                    item->body = x;
+                } else {
+                    item->env->lisp_vals[part - 2] = x;
+                }
+            }
+            v = lisp_promote_next(&items[n - 1]);
+            if (v) { break; }
+            x = lisp_promote_finish(&items[--n]);
+        }
+    }
+}
+
 //copy lisp env
 lisp_env* lisp_env_copy(lisp_env* e) {
-    lisp_env* new = malloc(sizeof(lisp_env));
+    lisp_env* new = create_lisp_env();
     new->parent = e->parent;
     new->count = e->count;
-    new->symbols = malloc(sizeof(char*) * new->count);
-    new->lisp_vals = malloc(sizeof(lisp_val*) * new->count);
+    lisp_env_alloc_entries(new, e->count);
     for(int i = 0; i < e->count; i++) {
-        new->symbols[i] = malloc(strlen(e->symbols[i]) + 1);
-        strcpy(new->symbols[i], e->symbols[i]);
+        new->symbols[i] = e->symbols[i];
+        new->symbols[i]->binds++;
         new->lisp_vals[i] = lisp_val_copy(e->lisp_vals[i]);
     }
+    lisp_env_reindex(new);
     return new;
 }
 
-lisp_val* lisp_val_pop(lisp_val* v, int i);
-lisp_val* builtin_eval(lisp_env* e, lisp_val* v);
+// mark-sweep garbage collector. reference counting frees almost everything as soon as it
+// is dropped; the collector reclaims what it can't: cycles and leaked references. it is rooted
+// at the global env plus the values pushed with lisp_gc_root, and only runs at safe points
+// between top-level forms, when no other value is in flight. the objects are found by walking
+// the slabs, so builds with -DLISP_NO_SLAB have no collector; -DLISP_NO_GC leaves it out of
+// slab builds too, freeing by reference counting alone. automatic collections start once
+// LISP_GC_MIN_THRESHOLD objects are live, and after that whenever the heap has doubled.
+#if defined(LISP_NO_SLAB) && !defined(LISP_NO_GC)
+#define LISP_NO_GC
+#endif
+#define LISP_GC_MARK 0x40000000
+#ifndef LISP_GC_MIN_THRESHOLD
+#define LISP_GC_MIN_THRESHOLD 65536
+#endif
+
+lisp_val** lisp_gc_roots = NULL;
+int lisp_gc_root_count = 0;
+int lisp_gc_root_size = 0;
+
+// nesting of top-level evaluations, collections only happen at depth 0
+int lisp_gc_eval_depth = 0;
+int lisp_gc_requested = 0;
+long lisp_gc_threshold = LISP_GC_MIN_THRESHOLD;
+
+// collector statistics, reported by the 'gc-stats' builtin
+long lisp_gc_collections = 0;
+long lisp_gc_reclaimed = 0;
+long lisp_gc_last_pause = 0;
+long lisp_gc_max_pause = 0;
+long lisp_gc_total_pause = 0;
+
+// keep v alive across safe points
+void lisp_gc_root(lisp_val* v) {
+    if (lisp_gc_root_count == lisp_gc_root_size) {
+        lisp_gc_root_size = lisp_gc_root_size ? lisp_gc_root_size * 2 : 16;
+        lisp_gc_roots = realloc(lisp_gc_roots, sizeof(lisp_val*) * lisp_gc_root_size);
+    }
+    lisp_gc_roots[lisp_gc_root_count++] = v;
+}
 
-lisp_val* builtin_list(lisp_env* e, lisp_val* v); 
+void lisp_gc_unroot() {
+    lisp_gc_root_count--;
+}
 
-// call function
-lisp_val* lisp_val_call(lisp_env* e, lisp_val* f, lisp_val* v) {
-    if(f->builtin) {
-        return f->builtin(e, v);
+#ifndef LISP_NO_GC
+
+void** lisp_gc_stack = NULL;
+int lisp_gc_stack_count = 0;
+int lisp_gc_stack_size = 0;
+
+// queue an object for marking, unless it is already marked
+void lisp_gc_push(void* p) {
+    if (p == NULL || lisp_val_is_fixnum(p) || lisp_region_contains(p)) { return; }
+    int* tag = p;
+    // static errors are not in the slabs, and are never freed
+    if (*tag == LISP_VAL_ERR && (((lisp_val*) p)->err_flags & LISP_ERR_STATIC)) { return; }
+    if (*tag & LISP_GC_MARK) { return; }
+    *tag |= LISP_GC_MARK;
+    if (lisp_gc_stack_count == lisp_gc_stack_size) {
+        lisp_gc_stack_size = lisp_gc_stack_size ? lisp_gc_stack_size * 2 : 256;
+        lisp_gc_stack = realloc(lisp_gc_stack, sizeof(void*) * lisp_gc_stack_size);
+    }
+    lisp_gc_stack[lisp_gc_stack_count++] = p;
+}
+
+// mark everything reachable from the queued objects. envs don't own their parent, so it isn't followed
+void lisp_gc_mark() {
+    while (lisp_gc_stack_count) {
+        void* p = lisp_gc_stack[--lisp_gc_stack_count];
+        int tag = *(int*) p & ~LISP_GC_MARK;
+        if (tag == LISP_SLAB_ENV) {
+            lisp_env* e = p;
+            for (int i = 0; i < e->count; i++) { lisp_gc_push(e->lisp_vals[i]); }
+            continue;
+        }
+        lisp_val* v = p;
+        switch (tag) {
+            case LISP_VAL_SEXPR:
+            case LISP_VAL_QEXPR:
+                for (int i = 0; i < v->count; i++) { lisp_gc_push(v->cell[i]); }
+                break;
+            case LISP_VAL_FUNC:
+                if (!v->builtin) {
+                    lisp_gc_push(v->env);
+                    lisp_gc_push(v->formals);
+                    lisp_gc_push(v->body);
+                }
+                break;
+        }
     }
+}
 
-    int count = v->count;
-    int total = f->formals->count;
+// a garbage object drops its references to live objects. references to other garbage are ignored,
+// since that is reclaimed in the same sweep. also used for envs, whose type and refs match a val's
+void lisp_gc_unref(lisp_val* v) {
+    if (lisp_val_is_fixnum(v) || lisp_region_contains(v) || !(v->type & LISP_GC_MARK)) { return; }
+    if (v->refs > 1) { v->refs--; }
+}
 
-    while(v->count) {
-        if(f->formals->count == 0) {
-            free_lisp_val(v);
-            return create_lv_err(
-        "Function passed too many arguments. "
-        "Got %i, Expected %i.", count, total);
+// free whatever a garbage object owns outside of the slabs
+void lisp_gc_release(void* p) {
+    int tag = *(int*) p;
+    if (tag == LISP_SLAB_ENV) {
+        lisp_env* e = p;
+        for (int i = 0; i < e->count; i++) {
+            e->symbols[i]->binds--;
+            lisp_gc_unref(e->lisp_vals[i]);
         }
-        lisp_val* symbol = lisp_val_pop(f->formals, 0);
-        if (strcmp(symbol->symbol, "&") == 0) {
-            if (f->formals->count != 1) {
-                free_lisp_val(v);
-                return create_lv_err("Function format invalid. "
-                  "Symbol '&' not followed by single symbol.");
-              }
-            
-            lisp_val* nsym = lisp_val_pop(f->formals, 0);
-            lisp_env_put(f->env, nsym, builtin_list(e, v));
-            free_lisp_val(symbol);
-            free_lisp_val(nsym);
+        free(e->symbols);
+        free(e->index);
+        return;
+    }
+    lisp_val* v = p;
+    switch (tag) {
+        case LISP_VAL_STRING: lisp_str_free(v->str); break;
+        case LISP_VAL_ERR:    if (v->err_flags & LISP_ERR_OWNED) { free(v->err_args[0].s); } break;
+        case LISP_VAL_SEXPR:
+        case LISP_VAL_QEXPR:
+            for (int i = 0; i < v->count; i++) { lisp_gc_unref(v->cell[i]); }
+            lisp_val_free_cells(v);
+            break;
+        case LISP_VAL_FUNC:
+            if (!v->builtin) {
+                lisp_gc_unref((lisp_val*) v->env);
+                lisp_gc_unref(v->formals);
+                lisp_gc_unref(v->body);
+                lisp_code_free(v->code);
+            }
             break;
-        }
-        lisp_val* val = lisp_val_pop(v, 0);
-        lisp_env_put(f->env, symbol, val);
-        free_lisp_val(symbol);
-        free_lisp_val(val);
     }
-    free_lisp_val(v);
-    if (f->formals->count > 0 && strcmp(f->formals->cell[0]->symbol, "&") == 0) {
-        if (f->formals->count != 2) {
-            return create_lv_err("Function format invalid. Symbol '&' not followed by single symbol.");
+}
+
+// visit every carved object of every slab
+void lisp_gc_walk(void (*visit)(void*)) {
+    for (int c = 0; c < LISP_SLAB_CLASSES; c++) {
+        lisp_slab_class* sc = &lisp_slab_classes[c];
+        for (lisp_slab* slab = sc->slabs; slab; slab = slab->next) {
+            char* obj = (char*) (slab + 1);
+            char* end = slab == sc->slabs ? sc->next
+                : obj + (LISP_SLAB_BYTES - sizeof(lisp_slab)) / slab->obj_size * slab->obj_size;
+            for (; obj < end; obj += slab->obj_size) {
+                visit(obj);
+            }
         }
-      
-        free_lisp_val(lisp_val_pop(f->formals, 0));
-      
-        lisp_val* symbol = lisp_val_pop(f->formals, 0);
-        lisp_val* val = create_lv_qexpr();
-      
-        lisp_env_put(f->env, symbol, val);
-        free_lisp_val(symbol); 
-        free_lisp_val(val);
-    }
-    if(f->formals->count == 0) {
-        f->env->parent = e;
-        return builtin_eval(f->env, lisp_val_add(create_lv_sexpr(), lisp_val_copy(f->body)));
-    }
-    // return partially evaluated function
-    return lisp_val_copy(f);
-}
-
-// take two lisp vals + operator and return the result of the operation
-lisp_val* evaluate_op(lisp_val x1, char* operator, lisp_val x2) {
-    
-    if (strcmp(operator, "+") == 0) { return create_lv_num(x1.num + x2.num); }
-    if (strcmp(operator, "-") == 0) { return create_lv_num(x1.num - x2.num); }
-    if (strcmp(operator, "*") == 0) { return create_lv_num(x1.num * x2.num); }
-    if (strcmp(operator, "/") == 0) {
-    /* If second operand is zero return error */
-    return x2.num == 0 
-      ? create_lv_err("Divided by zero!") : create_lv_num(x1.num / x2.num);
-  }
-    if (strcmp(operator, "%") == 0) { return create_lv_num(x1.num % x2.num); }
-    if (strcmp(operator, "^") == 0) { return create_lv_num(pow(x1.num, x2.num)); }
-    return create_lv_err("Bad operation %s!", operator);
+    }
+}
 
+void lisp_gc_sweep_release(void* p) {
+    int tag = *(int*) p;
+    if (tag != LISP_SLAB_FREE && !(tag & LISP_GC_MARK)) {
+        lisp_gc_release(p);
+    }
 }
 
-// take child i from lisp val cells, remove from cells, return it.
-lisp_val* lisp_val_pop(lisp_val* v, int i) {
+long lisp_gc_swept;
 
-    lisp_val* x = v->cell[i];
+void lisp_gc_sweep_free(void* p) {
+    int* tag = p;
+    if (*tag == LISP_SLAB_FREE) { return; }
+    if (*tag & LISP_GC_MARK) {
+        *tag &= ~LISP_GC_MARK;
+        return;
+    }
+    size_t size = sizeof(lisp_env);
+    if (*tag != LISP_SLAB_ENV) {
+        size = lisp_val_size(p);
+        lisp_val_frees++;
+        lisp_val_bytes -= size;
+    }
+    lisp_slab_free(p, size);
+    lisp_gc_swept++;
+}
+
+#endif
+
+// run a full collection, returns the number of objects reclaimed
+long lisp_gc_collect() {
+#ifdef LISP_NO_GC
+    return 0;
+#else
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    lisp_gc_push(lisp_global_env);
+    for (int i = 0; i < lisp_gc_root_count; i++) { lisp_gc_push(lisp_gc_roots[i]); }
+    for (int i = 0; i < lisp_intern_size; i++) { lisp_gc_push(lisp_intern_table[i]); }
+    lisp_gc_mark();
+
+    // release first, so garbage can still tell its live children (marked) from other garbage
+    lisp_gc_swept = 0;
+    lisp_gc_walk(lisp_gc_sweep_release);
+    lisp_gc_walk(lisp_gc_sweep_free);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    long pause = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+    lisp_gc_collections++;
+    lisp_gc_reclaimed += lisp_gc_swept;
+    lisp_gc_last_pause = pause;
+    lisp_gc_total_pause += pause;
+    if (pause > lisp_gc_max_pause) { lisp_gc_max_pause = pause; }
+
+    // next automatic collection once the heap has doubled
+    lisp_gc_threshold = lisp_slab_live * 2;
+    if (lisp_gc_threshold < LISP_GC_MIN_THRESHOLD) { lisp_gc_threshold = LISP_GC_MIN_THRESHOLD; }
+    return lisp_gc_swept;
+#endif
+}
+
+// called between top-level forms: collect if asked to, or if the heap grew past the threshold
+void lisp_gc_safe_point() {
+    if (lisp_gc_eval_depth > 0) { return; }
+    if (lisp_gc_requested || lisp_slab_live >= lisp_gc_threshold) {
+        lisp_gc_requested = 0;
+        lisp_gc_collect();
+    }
+}
+
+void lisp_eval_cache_flush();
+
+// start evaluating a top-level form (a REPL line, or a form of a loaded file)
+void lisp_toplevel_begin() {
+    if (lisp_gc_eval_depth++ == 0) { lisp_region_open(); }
+}
+
+// a top-level form is done: drop its temporaries and maybe collect garbage
+void lisp_toplevel_end() {
+    if (--lisp_gc_eval_depth == 0) {
+        lisp_eval_cache_flush();
+        lisp_region_drop();
+        lisp_code_drop_region();
+        lisp_gc_safe_point();
+    }
+}
+
+lisp_val* lisp_val_pop(lisp_val* v, int i);
+lisp_val* builtin_eval(lisp_env* e, int argc, lisp_val** argv);
+lisp_val* lisp_val_eval_cells(lisp_env* e, lisp_val* x);
+
+lisp_val* builtin_list(lisp_env* e, int argc, lisp_val** argv);
+
+lisp_val* lisp_vm_run(lisp_val* f, lisp_env* frame);
+
+// bind the arguments v of a call to lambda f in a fresh frame, and return the frame for the body
+// to run in. if there is nothing to run, returns NULL with the result (an error, or a partial
+// application) in *result, and f is freed. takes ownership of v
+lisp_env* lisp_val_bind(lisp_val* f, lisp_val* v, lisp_val** result) {
+
+    // the function itself is left untouched: a call binds the arguments by position in a fresh
+    // frame, after the arguments of earlier partial applications (which are all f->env holds)
+    lisp_val* formals = f->formals;
+    int fixed = 0;
+    while (fixed < formals->count && formals->cell[fixed]->interned != lisp_sym_rest) { fixed++; }
+    int rest = fixed < formals->count;
+    int bound = f->env->count;
+
+    // checked up front, before anything is bound
+    if (rest && fixed != formals->count - 2 && bound + v->count >= fixed) {
+        free_lisp_val(v);
+        free_lisp_val(f);
+        *result = create_lv_err(ERROR_BAD_FORMALS, "Function format invalid. "
+            "Symbol '&' not followed by single symbol.");
+        return NULL;
+    }
+    if (!rest && bound + v->count > fixed) {
+        *result = create_lv_err(ERROR_ARITY,
+            "Function passed too many arguments. "
+            "Got %i, Expected %i.", v->count, fixed - bound);
+        free_lisp_val(v);
+        free_lisp_val(f);
+        return NULL;
+    }
+
+    lisp_env* frame = create_lisp_env();
+    lisp_env_alloc_entries(frame, fixed + rest);
+    for (int i = 0; i < bound; i++) {
+        lisp_env_bind(frame, f->env->symbols[i], lisp_val_copy(f->env->lisp_vals[i]));
+    }
+
+    // the frame takes the arguments over from v, whatever is left is the rest list
+    v = lisp_val_own(v);
+    int taken = 0;
+    while (taken < v->count && frame->count < fixed) {
+        lisp_env_bind(frame, formals->cell[frame->count]->interned, v->cell[taken++]);
+    }
+    memmove(&v->cell[0], &v->cell[taken], sizeof(lisp_val*) * (v->count - taken));
+    v->count -= taken;
+
+    // not all formals bound yet: return a partial application holding the frame
+    if (frame->count < fixed) {
+        free_lisp_val(v);
+        lisp_val* partial = lisp_val_alloc(LISP_VAL_FUNC, LISP_VAL_SIZE(code));
+        partial->builtin = NULL;
+        partial->env = frame;
+        partial->formals = lisp_val_copy(formals);
+        partial->body = lisp_val_copy(f->body);
+        partial->code = lisp_code_copy(f->code);
+        free_lisp_val(f);
+        *result = partial;
+        return NULL;
+    }
+
+    if (rest) {
+        v->type = LISP_VAL_QEXPR;
+        lisp_env_bind(frame, formals->cell[fixed + 1]->interned, v);
+    } else {
+        free_lisp_val(v);
+    }
+    return frame;
+}
+
+// take argument i of a builtin over from the caller, who then leaves it alone
+static inline lisp_val* lisp_arg_take(lisp_val** argv, int i) {
+    lisp_val* x = argv[i];
+    argv[i] = NULL;
+    return x;
+}
+
+// free the arguments of a builtin call, but the ones the builtin took over
+void lisp_args_free(int argc, lisp_val** argv) {
+    for (int i = 0; i < argc; i++) {
+        if (argv[i]) { free_lisp_val(argv[i]); }
+    }
+}
+
+// call builtin f with the argc values in argv, once it is sure to take that many. the values are
+// only borrowed: they stay the caller's to free after the call, except for any the builtin took
+// over with lisp_arg_take (to return it, or change it in place, without copying it)
+lisp_val* lisp_builtin_call(lisp_env* e, lisp_val* f, int argc, lisp_val** argv) {
+    if (argc >= f->min_args && (f->max_args < 0 || argc <= f->max_args)) {
+        return f->builtin(e, argc, argv);
+    }
+    if (f->min_args == f->max_args && f->min_args == 1) {
+        return create_lv_err(ERROR_ARITY, "'%s' takes only 1 argument. Got %i", f->name, argc);
+    }
+    if (f->min_args == f->max_args) {
+        return create_lv_err(ERROR_ARITY, "'%s' takes exactly %i arguments. Got %i",
+            f->name, f->min_args, argc);
+    }
+    if (argc < f->min_args) {
+        return create_lv_err(ERROR_ARITY, "'%s' takes at least %i argument(s). Got %i",
+            f->name, f->min_args, argc);
+    }
+    return create_lv_err(ERROR_ARITY, "'%s' takes at most %i argument(s). Got %i",
+        f->name, f->max_args, argc);
+}
+
+// call function. takes ownership of f and v
+lisp_val* lisp_val_call(lisp_env* e, lisp_val* f, lisp_val* v) {
+    if(f->builtin) {
+        lisp_val* result = lisp_builtin_call(e, f, v->count, v->cell);
+        lisp_args_free(v->count, v->cell);
+        v->count = 0;
+        free_lisp_val(v);
+        free_lisp_val(f);
+        return result;
+    }
+
+    lisp_val* result;
+    lisp_env* frame = lisp_val_bind(f, v, &result);
+    if (frame == NULL) { return result; }
+    frame->parent = e;
+    return lisp_vm_run(f, frame);
+}
+
+// take child i from lisp val cells, remove from cells, return it. v must not be shared
+lisp_val* lisp_val_pop(lisp_val* v, int i) {
+
+    lisp_val* x = v->cell[i];
 
     // shift memory 
     memmove(&v->cell[i], &v->cell[i+1],
       sizeof(lisp_val*) * (v->count-i-1));
 
+    // the capacity is kept, the expression usually shrinks to nothing anyway
     v->count--;
-
-    // re-allocate memory
-    v->cell = realloc(v->cell, sizeof(lisp_val*) * v->count);
     return x;
 }
 
 // take child i from lisp val cells, then wipe the lisp val
 lisp_val* lisp_val_take(lisp_val* v, int i) {
-    lisp_val* x = lisp_val_pop(v, i);
+    lisp_val* x = lisp_val_copy(v->cell[i]);
     free_lisp_val(v);
     return x;
 }
 
 // take head of q-expr
-lisp_val* builtin_head(lisp_env* e, lisp_val* v) {
-    LASSERT(v, v->count == 1, "'head' takes only 1 argument. Got %i", v->count);
-    LASSERT(v, v->cell[0]->type == LISP_VAL_QEXPR, "Cannot take 'head' of non-q-expression.");
-    LASSERT(v, v->cell[1]->count != 0, "'head' passed empty q-expression");
+lisp_val* builtin_head(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "Cannot take 'head' of non-q-expression.");
+    LASSERT(argv[0]->count != 0, ERROR_EMPTY, "'head' passed empty q-expression");
 
-    lisp_val* lv = lisp_val_take(v, 0);
-    while(lv->count > 1) {
-        free_lisp_val(lisp_val_pop(lv, 1));
-    }
-    return lv;
+    return lisp_val_add(create_lv_qexpr(), lisp_val_copy(argv[0]->cell[0]));
 }
 
 // take tail of q-expr
-lisp_val* builtin_tail(lisp_env* e, lisp_val* v) {
-    LASSERT(v, v->count == 1, "'tail' takes only 1 argument. Got %i", v->count);
-    LASSERT(v, v->cell[0]->type == LISP_VAL_QEXPR, "Cannot take 'tail' of non-q-expression.");
-    LASSERT(v, v->cell[1]->count != 0, "'tail' passed empty q-expression");
+lisp_val* builtin_tail(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "Cannot take 'tail' of non-q-expression.");
+    LASSERT(argv[0]->count != 0, ERROR_EMPTY, "'tail' passed empty q-expression");
 
-    lisp_val* lv = lisp_val_take(v, 0);
+    lisp_val* lv = lisp_val_own(lisp_arg_take(argv, 0));
     free_lisp_val(lisp_val_pop(lv, 0));
     return lv;
 }
 
-// convert s-expr to q-expr
-lisp_val* builtin_list(lisp_env* e, lisp_val* v) {
-    v->type = LISP_VAL_QEXPR;
+// collect the arguments into a q-expr
+lisp_val* builtin_list(lisp_env* e, int argc, lisp_val** argv) {
+    lisp_val* v = create_lv_qexpr();
+    lisp_val_reserve(v, argc);
+    for (int i = 0; i < argc; i++) {
+        v->cell[i] = lisp_arg_take(argv, i);
+    }
+    v->count = argc;
     return v;
 }
 
 // takes a value and a Q-Expression and appends it to the front
-lisp_val* builtin_cons(lisp_env* e, lisp_val* v) {
-    LASSERT(v, v->count == 2, "'cons' takes exactly 2 arguments. Got %i", v->count);
-    LASSERT(v, v->cell[1]->type == LISP_VAL_QEXPR,
-            "'cons' requires the second parameter to be a q-expression.");
-    LASSERT(v, v->cell[1]->count != 0, "'cons' passed empty q-expression");
-
-    lisp_val* lv2 = lisp_val_pop(v, 1);
-    lisp_val* lv1 = lisp_val_take(v, 0);
+lisp_val* builtin_cons(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[1]) == LISP_VAL_QEXPR,
+            ERROR_TYPE, "'cons' requires the second parameter to be a q-expression.");
+    LASSERT(argv[1]->count != 0, ERROR_EMPTY, "'cons' passed empty q-expression");
 
-    lv2 = lisp_val_add_at_head(lv2, lv1);
-    return lv2;
+    return lisp_val_add_at_head(lisp_arg_take(argv, 1), lisp_arg_take(argv, 0));
 }
 
 // returns length of q expression
-lisp_val* builtin_len(lisp_env* e, lisp_val* v) {
-
-    LASSERT(v, v->count == 1, "'len' takes only 1 argument. Got %i", v->count);
-    LASSERT(v, v->cell[0]->type == LISP_VAL_QEXPR, "Cannot take 'len' of non-q-expression.");
-
-    lisp_val* lv = lisp_val_take(v, 0);
-
-    return create_lv_num(lv->count);
+lisp_val* builtin_len(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "Cannot take 'len' of non-q-expression.");
 
+    return create_lv_num(argv[0]->count);
 }
 
 // takes a q-expression and returns all of it except last element
-lisp_val* builtin_init(lisp_env* e, lisp_val* v) {
-    LASSERT(v, v->count == 1, "'init' takes only 1 argument. Got %i", v->count);
-    LASSERT(v, v->cell[0]->type == LISP_VAL_QEXPR, "Cannot take 'init' of non-q-expression.");
-    LASSERT(v, v->cell[1]->count != 0, "'init' passed empty q-expression");
-
-    lisp_val* lv = lisp_val_take(v, 0);
+lisp_val* builtin_init(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "Cannot take 'init' of non-q-expression.");
+    LASSERT(argv[0]->count != 0, ERROR_EMPTY, "'init' passed empty q-expression");
 
-    lisp_val_pop(lv, lv->count - 1);
+    lisp_val* lv = lisp_val_own(lisp_arg_take(argv, 0));
+    free_lisp_val(lisp_val_pop(lv, lv->count - 1));
     return lv;
 }
 
 lisp_val* lisp_val_eval(lisp_env* e, lisp_val* v);
 
-// change q-expr to s-expr and evaluate
-lisp_val* builtin_eval(lisp_env* e, lisp_val* v) {
-    LASSERT(v, v->count == 1, "'eval' takes only 1 argument. Got %i", v->count);
-    LASSERT(v, v->cell[0]->type == LISP_VAL_QEXPR, "Cannot take 'eval' of non-q-expression.");
-
-    lisp_val* lv = lisp_val_take(v, 0);
-    lv->type = LISP_VAL_SEXPR;
-
-    return lisp_val_eval(e, lv);
+// evaluate a q-expr as an s-expr
+lisp_val* builtin_eval(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "Cannot take 'eval' of non-q-expression.");
 
+    return lisp_val_eval_cells(e, argv[0]);
 }
 
-// join multiple lisp vals
-lisp_val* lisp_val_join(lisp_val* v1, lisp_val* v2) {
-    while(v2->count > 0) {
-        v1 = lisp_val_add(v1, lisp_val_pop(v2, 0));
+// join multiple q-exprs. the first one grows by the cells of the others, all at once
+lisp_val* builtin_join(lisp_env* e, int argc, lisp_val** argv) {
+    int count = 0;
+    for (int i = 0; i < argc; i++) {
+        LASSERT(lisp_val_type(argv[i]) == LISP_VAL_QEXPR, ERROR_TYPE, "'join' passed non-q-expression.");
+        count += argv[i]->count;
     }
 
-    free_lisp_val(v2);
-    
-    return v1;
-}
-
-// join multiple q-exprs
-lisp_val* builtin_join(lisp_env* e, lisp_val* v) {
-    for (int i = 0; i < v->count; i++) {
-        LASSERT(v, v->cell[i]->type == LISP_VAL_QEXPR,"'join' passed non-q-expression.");
-    }
-    lisp_val* lv = lisp_val_pop(v, 0);
-    
-    while(v->count > 0) {
-        lv = lisp_val_join(lv, lisp_val_pop(v, 0));
+    lisp_val* lv = lisp_val_own(lisp_arg_take(argv, 0));
+    lisp_val_reserve(lv, count);
+    for (int i = 1; i < argc; i++) {
+        for (int j = 0; j < argv[i]->count; j++) {
+            lv->cell[lv->count++] = lisp_val_copy(argv[i]->cell[j]);
+        }
     }
-    
-    free_lisp_val(v);
     return lv;
 }
 
-lisp_val* builtin_var(lisp_env* e, lisp_val* v, char* func) {
-    LASSERT(v, v->cell[0]->type == LISP_VAL_QEXPR, "'%s' must be q-expression", func);
+// bind each symbol of argv[0] to the value after it, with def or put. func names it for errors
+lisp_val* builtin_var(lisp_env* e, int argc, lisp_val** argv, char* func,
+                      void (*bind)(lisp_env*, lisp_val*, lisp_val*)) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "'%s' must be q-expression", func);
 
     // 1st arg -- list of symbols
-    lisp_val* symbols = v->cell[0];
+    lisp_val* symbols = argv[0];
 
     // if not all are symbols, error out
     for (int i = 0; i < symbols->count; i++) {
-        LASSERT(v, symbols->cell[i]->type == LISP_VAL_SYMBOL, "Arguments must be symbols!");
+        LASSERT(lisp_val_type(symbols->cell[i]) == LISP_VAL_SYMBOL, ERROR_TYPE, "Arguments must be symbols!");
     }
 
-    LASSERT(v, v->count - 1 == symbols->count, 
-            "'%s' argument mismatch: there must be a value for each symbol. \
-            Values: %i, Symbols: %i", func, v->count - 1, symbols->count);
+    LASSERT(argc - 1 == symbols->count,
+            ERROR_ARITY, "'%s' argument mismatch: there must be a value for each symbol. \
+            Values: %i, Symbols: %i", func, argc - 1, symbols->count);
 
     for(int i = 0; i < symbols->count; i++) {
-        if(strcmp(func, "=") == 0) {
-            lisp_env_put(e, symbols->cell[i], v->cell[i+1]);
-        }
-
-        if(strcmp(func, "def") == 0) {
-            lisp_env_def(e, symbols->cell[i], v->cell[i+1]);
-        }
+        bind(e, symbols->cell[i], argv[i+1]);
     }
 
-    free_lisp_val(v);
     // on success print ()
     return create_lv_sexpr();
 }
 
-lisp_val* builtin_def(lisp_env* e, lisp_val* v) {
-    return builtin_var(e, v, "def");
+lisp_val* builtin_def(lisp_env* e, int argc, lisp_val** argv) {
+    return builtin_var(e, argc, argv, "def", lisp_env_def);
 }
 
-lisp_val* builtin_put(lisp_env* e, lisp_val* v) {
-    return builtin_var(e, v, "=");
+lisp_val* builtin_put(lisp_env* e, int argc, lisp_val** argv) {
+    return builtin_var(e, argc, argv, "=", lisp_env_put);
 }
 
-lisp_val* builtin_lambda(lisp_env* e, lisp_val* v) {
-    LASSERT(v, v->count == 2, "'lambda' takes exactly two arguments.");
-
-    LASSERT(v, v->cell[0]->type == LISP_VAL_QEXPR, "'lambda' must use q-expression for argument 1");
-    LASSERT(v, v->cell[1]->type == LISP_VAL_QEXPR, "'lambda' must use q-expression for argument 2");
-
-    for(int i = 0; i < v->cell[0]->count; i++) {
-        LASSERT(v, v->cell[0]->cell[i]->type == LISP_VAL_SYMBOL, "Cannot define non-symbol."); 
+// formals of the lambdas around the code being resolved, innermost first
+typedef struct lisp_scope {
+    lisp_val* formals;
+    struct lisp_scope* parent;
+} lisp_scope;
+
+// frame slot a call binds symbol sym to, -1 if it isn't one of the formals. '&' takes no slot
+int lisp_scope_slot(lisp_val* formals, lisp_val* sym) {
+    int slot = 0;
+    for (int i = 0; i < formals->count; i++) {
+        lisp_val* f = formals->cell[i];
+        if (lisp_val_type(f) != LISP_VAL_SYMBOL) { return -1; }
+        if (f->interned == lisp_sym_rest) { continue; }
+        if (f->interned == sym) { return slot; }
+        slot++;
     }
-    lisp_val* formals = lisp_val_pop(v, 0);
-    lisp_val* body = lisp_val_pop(v, 0);
-    free_lisp_val(v);
-
-    return create_lv_lambda(formals, body);
-}
-
-// perform operation on lisp val
-lisp_val* builtin_op(lisp_env* e, lisp_val* a, char* op) {
-
-    for (int i = 0; i < a->count; i++) {
-        if (a->cell[i]->type != LISP_VAL_NUM) {
-            free_lisp_val(a);
-            return create_lv_err("Operation must be done on numbers.");
+    return -1;
+}
+
+// replace the references in v to formals of the lambdas in scope by (depth, slot) references.
+// a (\ {formals} {body}) written in v opens a new scope for its body, and a (let {bindings} {body})
+// one for its values and body, since it binds them in a frame of its own. takes ownership of v
+lisp_val* lisp_val_resolve(lisp_val* v, lisp_scope* scope) {
+    if (lisp_val_is_fixnum(v)) { return v; }
+
+    if (v->type == LISP_VAL_SYMBOL) {
+        int depth = 0;
+        for (lisp_scope* s = scope; s; s = s->parent, depth++) {
+            int slot = lisp_scope_slot(s->formals, v->interned);
+            if (slot < 0) { continue; }
+            if (v->depth == depth && v->slot == slot) { return v; }
+            lisp_val* ref = create_lv_symbol_ref(v, depth, slot);
+            free_lisp_val(v);
+            return ref;
         }
+        // anything else gets a reference of its own, to cache its global binding in
+        if (v == v->interned) {
+            lisp_val* ref = create_lv_symbol_ref(v, -1, -1);
+            free_lisp_val(v);
+            return ref;
+        }
+        return v;
     }
-
-    lisp_val* x = lisp_val_pop(a, 0);
-
-    // (- x) --> -x
-    if ((strcmp(op, "-") == 0) && a->count == 0) {
-        x->num = -x->num;
+    if (v->type != LISP_VAL_SEXPR && v->type != LISP_VAL_QEXPR) { return v; }
+
+    lisp_scope inner = { NULL, scope };
+    lisp_val* names = NULL;
+    int first = 0;
+    if (v->count == 3 && lisp_val_type(v->cell[0]) == LISP_VAL_SYMBOL
+            && v->cell[0]->interned == lisp_sym_lambda && lisp_val_type(v->cell[1]) == LISP_VAL_QEXPR) {
+        // the formals of a lambda are left alone
+        inner.formals = v->cell[1];
+        first = 2;
+    } else if (lisp_form_of(v) == LISP_FORM_LET) {
+        names = create_lv_qexpr();
+        for (int i = 0; i < v->cell[1]->count; i++) {
+            names = lisp_val_add(names, lisp_val_copy(v->cell[1]->cell[i]->cell[0]->interned));
+        }
+        inner.formals = names;
     }
+    for (int i = first; i < v->count; i++) {
+        lisp_val* x = lisp_val_resolve(lisp_val_copy(v->cell[i]), inner.formals && i > 0 ? &inner : scope);
+        if (x == v->cell[i]) {
+            free_lisp_val(x);
+            continue;
+        }
+        v = lisp_val_own(v);
+        free_lisp_val(v->cell[i]);
+        v->cell[i] = x;
+    }
+    if (names) { free_lisp_val(names); }
+    return v;
+}
 
-    // run over all elements
-    while (a->count > 0) {
+lisp_val* builtin_lambda(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "'lambda' must use q-expression for argument 1");
+    LASSERT(lisp_val_type(argv[1]) == LISP_VAL_QEXPR, ERROR_TYPE, "'lambda' must use q-expression for argument 2");
 
-      // get next elem
-        lisp_val* y = lisp_val_pop(a, 0);
+    for(int i = 0; i < argv[0]->count; i++) {
+        LASSERT(lisp_val_type(argv[0]->cell[i]) == LISP_VAL_SYMBOL, ERROR_TYPE, "Cannot define non-symbol."); 
+    }
 
-        if (strcmp(op, "+") == 0) { x->num += y->num; }
-        if (strcmp(op, "-") == 0) { x->num -= y->num; }
-        if (strcmp(op, "*") == 0) { x->num *= y->num; }
-        if (strcmp(op, "/") == 0) {
-            if (y->num == 0) {
-                free_lisp_val(x); free_lisp_val(y);
-                x = create_lv_err("Division by zero error.");
-                break;
-            }
-            x->num /= y->num;
+    // calls bind arguments by position, so every formal must be a different symbol
+    lisp_val* fs = argv[0];
+    for (int i = 0; i < fs->count; i++) {
+        for (int j = 0; j < i; j++) {
+            LASSERT(fs->cell[i]->interned != fs->cell[j]->interned, ERROR_BAD_FORMALS,
+                "Function format invalid. Symbol '%s' appears twice.", fs->cell[i]->symbol);
         }
-        free_lisp_val(y);
     }
+    lisp_val* formals = lisp_arg_take(argv, 0);
+    lisp_val* body = lisp_arg_take(argv, 1);
 
-    free_lisp_val(a);
-    return x;
+    // references to the formals become frame slots, so calls don't search for them by name
+    lisp_scope scope = { formals, NULL };
+    body = lisp_val_resolve(body, &scope);
+
+    return create_lv_lambda(formals, body);
 }
 
-lisp_val* builtin_add(lisp_env* e, lisp_val* v) {
-    return builtin_op(e, v, "+");
+// each arithmetic builtin is its own kernel, so the operator is fixed when the builtin is
+// registered instead of being looked up for every operand. all of them take numbers only
+static inline int lisp_args_nums(int argc, lisp_val** argv) {
+    for (int i = 0; i < argc; i++) {
+        if (lisp_val_type(argv[i]) != LISP_VAL_NUM) { return 0; }
+    }
+    return 1;
 }
 
+#define LISP_ASSERT_NUMS(argc, argv) \
+    LASSERT(lisp_args_nums(argc, argv), ERROR_TYPE, "Operation must be done on numbers.")
 
-lisp_val* builtin_sub(lisp_env* e, lisp_val* v) {
-    return builtin_op(e, v, "-");
+// accumulate into a plain long, only the result becomes a lisp val
+lisp_val* builtin_add(lisp_env* e, int argc, lisp_val** argv) {
+    LISP_ASSERT_NUMS(argc, argv);
+    long x = lisp_val_num(argv[0]);
+    for (int i = 1; i < argc; i++) { x += lisp_val_num(argv[i]); }
+    return create_lv_num(x);
 }
 
+lisp_val* builtin_sub(lisp_env* e, int argc, lisp_val** argv) {
+    LISP_ASSERT_NUMS(argc, argv);
+    long x = lisp_val_num(argv[0]);
 
-lisp_val* builtin_mul(lisp_env* e, lisp_val* v) {
-    return builtin_op(e, v, "*");
+    // (- x) --> -x
+    if (argc == 1) { return create_lv_num(-x); }
+    for (int i = 1; i < argc; i++) { x -= lisp_val_num(argv[i]); }
+    return create_lv_num(x);
 }
 
+lisp_val* builtin_mul(lisp_env* e, int argc, lisp_val** argv) {
+    LISP_ASSERT_NUMS(argc, argv);
+    long x = lisp_val_num(argv[0]);
+    for (int i = 1; i < argc; i++) { x *= lisp_val_num(argv[i]); }
+    return create_lv_num(x);
+}
 
-lisp_val* builtin_div(lisp_env* e, lisp_val* v) {
-    return builtin_op(e, v, "/");
+lisp_val* builtin_div(lisp_env* e, int argc, lisp_val** argv) {
+    LISP_ASSERT_NUMS(argc, argv);
+    long x = lisp_val_num(argv[0]);
+    for (int i = 1; i < argc; i++) {
+        long y = lisp_val_num(argv[i]);
+        LASSERT(y != 0, ERROR_DIV_ZERO, "Division by zero error.");
+        x /= y;
+    }
+    return create_lv_num(x);
 }
 
-lisp_val* builtin_print(lisp_env* e, lisp_val* v) {
-    for(int i = 0; i < v->count; i++) {
-        lisp_val_print(v->cell[i]);
+lisp_val* builtin_print(lisp_env* e, int argc, lisp_val** argv) {
+    for(int i = 0; i < argc; i++) {
+        lisp_val_print(argv[i]);
         putchar(' ');
     }
     putchar('\n');
-    free_lisp_val(v);
 
     return create_lv_sexpr();
 }
 
-lisp_val* builtin_load(lisp_env* e, lisp_val* v) {
+// pair of symbol and number, used to report statistics
+lisp_val* create_lv_stat(char* name, long value) {
+    lisp_val* stat = create_lv_qexpr();
+    stat = lisp_val_add(stat, create_lv_symbol(name));
+    return lisp_val_add(stat, create_lv_num(value));
+}
+
+// report lisp val allocation counters
+lisp_val* builtin_mem_stats(lisp_env* e, int argc, lisp_val** argv) {
+    lisp_val* stats = create_lv_qexpr();
+    stats = lisp_val_add(stats, create_lv_stat("allocs", lisp_val_allocs));
+    stats = lisp_val_add(stats, create_lv_stat("frees", lisp_val_frees));
+    stats = lisp_val_add(stats, create_lv_stat("live", lisp_val_allocs - lisp_val_frees));
+    stats = lisp_val_add(stats, create_lv_stat("bytes", lisp_val_bytes));
+    long slab_allocs = lisp_slab_hits + lisp_slab_misses;
+    stats = lisp_val_add(stats, create_lv_stat("objects", lisp_slab_live));
+    stats = lisp_val_add(stats, create_lv_stat("slabs", lisp_slab_count));
+    stats = lisp_val_add(stats, create_lv_stat("slab-hits", lisp_slab_hits));
+    stats = lisp_val_add(stats, create_lv_stat("slab-misses", lisp_slab_misses));
+    stats = lisp_val_add(stats, create_lv_stat("hit-rate", slab_allocs ? lisp_slab_hits * 100 / slab_allocs : 0));
+    stats = lisp_val_add(stats, create_lv_stat("region-allocs", lisp_region_allocs));
+    stats = lisp_val_add(stats, create_lv_stat("region-high", lisp_region_high));
+    stats = lisp_val_add(stats, create_lv_stat("region-overflows", lisp_region_overflows));
+    return stats;
+}
+
+// report the size of the symbol intern table
+lisp_val* builtin_intern_stats(lisp_env* e, int argc, lisp_val** argv) {
+    lisp_val* stats = create_lv_qexpr();
+    stats = lisp_val_add(stats, create_lv_stat("symbols", lisp_intern_count));
+    stats = lisp_val_add(stats, create_lv_stat("capacity", lisp_intern_size));
+    stats = lisp_val_add(stats, create_lv_stat("name-bytes", lisp_intern_bytes));
+    return stats;
+}
+
+// report the bytes each type of lisp val takes up
+lisp_val* builtin_val_sizes(lisp_env* e, int argc, lisp_val** argv) {
+    lisp_val* sizes = create_lv_qexpr();
+    sizes = lisp_val_add(sizes, create_lv_stat("num",     LISP_VAL_SIZE(num)));
+    sizes = lisp_val_add(sizes, create_lv_stat("err",     LISP_VAL_SIZE(err_args)));
+    sizes = lisp_val_add(sizes, create_lv_stat("symbol",  LISP_VAL_SIZE(binds)));
+    sizes = lisp_val_add(sizes, create_lv_stat("string",  LISP_VAL_SIZE(str)));
+    sizes = lisp_val_add(sizes, create_lv_stat("builtin", LISP_VAL_SIZE(name)));
+    sizes = lisp_val_add(sizes, create_lv_stat("lambda",  LISP_VAL_SIZE(code)));
+    sizes = lisp_val_add(sizes, create_lv_stat("expr",    LISP_VAL_SIZE(cell_inline)));
+    return sizes;
+}
+
+// ask for a garbage collection, which runs once the current top-level form is done
+lisp_val* builtin_gc(lisp_env* e, int argc, lisp_val** argv) {
+    lisp_gc_requested = 1;
+    return create_lv_sexpr();
+}
+
+// microseconds on a monotonic clock, for timing code
+lisp_val* builtin_clock(lisp_env* e, int argc, lisp_val** argv) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return create_lv_num(now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+// report garbage collector statistics, pause times are in microseconds
+lisp_val* builtin_gc_stats(lisp_env* e, int argc, lisp_val** argv) {
+    lisp_val* stats = create_lv_qexpr();
+    stats = lisp_val_add(stats, create_lv_stat("collections", lisp_gc_collections));
+    stats = lisp_val_add(stats, create_lv_stat("reclaimed", lisp_gc_reclaimed));
+    stats = lisp_val_add(stats, create_lv_stat("heap", lisp_slab_live));
+    stats = lisp_val_add(stats, create_lv_stat("threshold", lisp_gc_threshold));
+    stats = lisp_val_add(stats, create_lv_stat("last-pause", lisp_gc_last_pause));
+    stats = lisp_val_add(stats, create_lv_stat("max-pause", lisp_gc_max_pause));
+    stats = lisp_val_add(stats, create_lv_stat("total-pause", lisp_gc_total_pause));
+    return stats;
+}
+
+lisp_val* builtin_load(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_STRING, ERROR_TYPE, "'load' must be passed a string.");
+
     mpc_result_t r;
-    if (mpc_parse_contents(v->cell[0]->string, Lispy, &r)) {
+    if (mpc_parse_contents(argv[0]->str->bytes, Lispy, &r)) {
         lisp_val* expr = lisp_val_read(r.output);
         mpc_ast_delete(r.output);
-        while (expr->count) {
-            lisp_val* x = lisp_val_eval(e, lisp_val_pop(expr, 0));
-            if (x->type == LISP_VAL_ERR) { lisp_val_print(x); }
+        lisp_gc_root(argv[0]);
+        lisp_gc_root(expr);
+        // forms are evaluated from shared copies, so the parsed file is never modified
+        for (int i = 0; i < expr->count; i++) {
+            lisp_toplevel_begin();
+            lisp_val* x = lisp_val_eval(e, lisp_val_copy(expr->cell[i]));
+            if (lisp_val_type(x) == LISP_VAL_ERR) { lisp_val_print(x); }
             free_lisp_val(x);
+            lisp_toplevel_end();
         }
+        lisp_gc_unroot();
+        lisp_gc_unroot();
         free_lisp_val(expr);
-        free_lisp_val(v);
         return create_lv_sexpr();
     } 
     else {
         char* err = mpc_err_string(r.error);
         mpc_err_delete(r.error);
 
-        lisp_val* lv_err = create_lv_err("Could not load Library %s", err);
+        lisp_val* lv_err = create_lv_err_copy(ERROR_LOAD, "Could not load Library %s", err);
         free(err);
-        free_lisp_val(v);
 
         return lv_err;
     }
 }
 
+// whether two lisp vals are equal. the pairs of cells still to compare are kept on an explicit
+// stack, so values of any depth can be compared
 int lisp_val_equals(lisp_val* x1, lisp_val* x2) {
-    if(x1->type != x2->type) {
-        return 0; // types are not equal
-    }
-    switch(x1->type) {
-        case LISP_VAL_NUM:    return x1->num == x2->num;
-        case LISP_VAL_STRING: return strcmp(x1->string, x2->string) == 0;
-        case LISP_VAL_ERR:    return strcmp(x1->err, x2->err) == 0;
-        case LISP_VAL_SYMBOL: return strcmp(x1->symbol, x2->symbol) == 0;
-        case LISP_VAL_QEXPR:
+    lisp_val* pending_inline[32];
+    lisp_val** pending = pending_inline;
+    int count = 0;
+    int size = 32;
+    int equal;
+
+    for (;;) {
+        equal = lisp_val_type(x1) == lisp_val_type(x2);
+        if (equal && x1 != x2) {
+            // room for the cells to compare later: of an expression, or formals and body of a lambda
+            int need = count + 4;
+            int type = lisp_val_type(x1);
+            if (type == LISP_VAL_SEXPR || type == LISP_VAL_QEXPR) { need += x1->count * 2; }
+            if (need > size) {
+                size = need * 2;
+                pending = pending == pending_inline
+                    ? memcpy(malloc(sizeof(lisp_val*) * size), pending_inline, sizeof(pending_inline))
+                    : realloc(pending, sizeof(lisp_val*) * size);
+            }
+
+            switch(lisp_val_type(x1)) {
+                case LISP_VAL_NUM:    equal = lisp_val_num(x1) == lisp_val_num(x2); break;
+                case LISP_VAL_STRING:
+                    equal = x1->str == x2->str || (x1->str->len == x2->str->len && x1->str->hash == x2->str->hash
+                        && memcmp(x1->str->bytes, x2->str->bytes, x1->str->len) == 0);
+                    break;
+                case LISP_VAL_ERR: {
+                    char msg1[512], msg2[512];
+                    lisp_err_format(x1, msg1, sizeof(msg1));
+                    lisp_err_format(x2, msg2, sizeof(msg2));
+                    equal = x1->err_code == x2->err_code && strcmp(msg1, msg2) == 0;
+                    break;
+                }
+                case LISP_VAL_SYMBOL: equal = x1->interned == x2->interned; break;
+                case LISP_VAL_QEXPR:
+                case LISP_VAL_SEXPR:
+                    equal = x1->count == x2->count;
+                    for (int i = 0; equal && i < x1->count; i++) {
+                        pending[count++] = x1->cell[i];
+                        pending[count++] = x2->cell[i];
+                    }
+                    break;
+                case LISP_VAL_FUNC:
+                    if(x1->builtin || x2->builtin) {
+                        equal = x1->builtin == x2->builtin;
+                        break;
+                    }
+                    pending[count++] = x1->formals;
+                    pending[count++] = x2->formals;
+                    pending[count++] = x1->body;
+                    pending[count++] = x2->body;
+                    break;
+            }
+        }
+        if (!equal || count == 0) { break; }
+        x2 = pending[--count];
+        x1 = pending[--count];
+    }
+    if (pending != pending_inline) { free(pending); }
+    return equal;
+}
+
+// comparisons, one kernel each like the arithmetic
+
+lisp_val* builtin_gt(lisp_env* e, int argc, lisp_val** argv) {
+    LISP_ASSERT_NUMS(2, argv);
+    return create_lv_num(lisp_val_num(argv[0]) > lisp_val_num(argv[1]));
+}
+
+lisp_val* builtin_gte(lisp_env* e, int argc, lisp_val** argv) {
+    LISP_ASSERT_NUMS(2, argv);
+    return create_lv_num(lisp_val_num(argv[0]) >= lisp_val_num(argv[1]));
+}
+
+lisp_val* builtin_lt(lisp_env* e, int argc, lisp_val** argv) {
+    LISP_ASSERT_NUMS(2, argv);
+    return create_lv_num(lisp_val_num(argv[0]) < lisp_val_num(argv[1]));
+}
+
+lisp_val* builtin_lte(lisp_env* e, int argc, lisp_val** argv) {
+    LISP_ASSERT_NUMS(2, argv);
+    return create_lv_num(lisp_val_num(argv[0]) <= lisp_val_num(argv[1]));
+}
+
+lisp_val* builtin_eq(lisp_env* e, int argc, lisp_val** argv) {
+    return create_lv_num(lisp_val_equals(argv[0], argv[1]));
+}
+
+lisp_val* builtin_neq(lisp_env* e, int argc, lisp_val** argv) {
+    return create_lv_num(!lisp_val_equals(argv[0], argv[1]));
+}
+
+lisp_val* builtin_if(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_NUM, ERROR_TYPE, "Argument 1 of 'if' must be bool");
+    LASSERT(lisp_val_type(argv[1]) == LISP_VAL_QEXPR, ERROR_TYPE, "Argument 1 of 'if' must be q-expression");
+    LASSERT(lisp_val_type(argv[2]) == LISP_VAL_QEXPR, ERROR_TYPE, "Argument 2 of 'if' must be q-expression");
+
+    return lisp_val_eval_cells(e, argv[lisp_val_num(argv[0]) ? 1 : 2]);
+}
+
+lisp_val* lisp_val_apply(lisp_env* e, lisp_val* v);
+lisp_val* lisp_val_eval_each(lisp_env* e, lisp_val* x);
+
+// the builtins of the other special forms, for when they aren't compiled inline: called through
+// another name, or with operands that aren't written out. see lisp_compile_special
+
+// (let {{x value} ...} {body}) binds each x to its value in a new frame, in order, and evaluates
+// the body there
+lisp_val* builtin_let(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "Argument 1 of 'let' must be q-expression");
+    LASSERT(lisp_val_type(argv[1]) == LISP_VAL_QEXPR, ERROR_TYPE, "Argument 2 of 'let' must be q-expression");
+    lisp_val* bindings = argv[0];
+    LASSERT(lisp_val_pairs(bindings->cell, bindings->count, 1), ERROR_TYPE,
+            "Bindings of 'let' must be {symbol value} pairs");
+
+    lisp_env* frame = create_lisp_env();
+    frame->parent = e;
+    for (int i = 0; i < bindings->count; i++) {
+        lisp_val* x = lisp_val_eval(frame, lisp_val_copy(bindings->cell[i]->cell[1]));
+        if (lisp_val_type(x) == LISP_VAL_ERR) {
+            free_lisp_env(frame);
+            return x;
+        }
+        lisp_env_put(frame, bindings->cell[i]->cell[0], x);
+        free_lisp_val(x);
+    }
+    lisp_val* result = lisp_val_eval_cells(frame, argv[1]);
+    free_lisp_env(frame);
+    return result;
+}
+
+// (cond {test value} ...) is the value of the first clause whose test isn't 0, () if there is none
+lisp_val* builtin_cond(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_pairs(argv, argc, 0), ERROR_TYPE, "Clauses of 'cond' must be {test value} pairs");
+    for (int i = 0; i < argc; i++) {
+        lisp_val* test = lisp_val_eval(e, lisp_val_copy(argv[i]->cell[0]));
+        if (lisp_val_type(test) == LISP_VAL_ERR) { return test; }
+        int type = lisp_val_type(test);
+        long n = type == LISP_VAL_NUM ? lisp_val_num(test) : 0;
+        free_lisp_val(test);
+        LASSERT(type == LISP_VAL_NUM, ERROR_TYPE, lisp_forms[LISP_FORM_COND].cond);
+        if (n) { return lisp_val_eval(e, lisp_val_copy(argv[i]->cell[1])); }
+    }
+    return create_lv_sexpr();
+}
+
+// (and x ...) is 1 if none of the x is 0, (or x ...) if any is. both stop at the first that decides
+lisp_val* builtin_and(lisp_env* e, int argc, lisp_val** argv) {
+    for (int i = 0; i < argc; i++) {
+        LASSERT(lisp_val_type(argv[i]) == LISP_VAL_NUM, ERROR_TYPE, lisp_forms[LISP_FORM_AND].cond);
+        if (lisp_val_num(argv[i]) == 0) { return create_lv_num(0); }
+    }
+    return create_lv_num(1);
+}
+
+lisp_val* builtin_or(lisp_env* e, int argc, lisp_val** argv) {
+    for (int i = 0; i < argc; i++) {
+        LASSERT(lisp_val_type(argv[i]) == LISP_VAL_NUM, ERROR_TYPE, lisp_forms[LISP_FORM_OR].cond);
+        if (lisp_val_num(argv[i]) != 0) { return create_lv_num(1); }
+    }
+    return create_lv_num(0);
+}
+
+// (while {cond} {body}) evaluates the body for as long as the condition isn't 0, and is (). an
+// error in either ends the loop, and is its value
+lisp_val* builtin_while(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "Argument 1 of 'while' must be q-expression");
+    LASSERT(lisp_val_type(argv[1]) == LISP_VAL_QEXPR, ERROR_TYPE, "Argument 2 of 'while' must be q-expression");
+    for (;;) {
+        lisp_val* cond = lisp_val_eval_cells(e, argv[0]);
+        if (lisp_val_type(cond) == LISP_VAL_ERR) { return cond; }
+        int type = lisp_val_type(cond);
+        long n = type == LISP_VAL_NUM ? lisp_val_num(cond) : 0;
+        free_lisp_val(cond);
+        LASSERT(type == LISP_VAL_NUM, ERROR_TYPE, lisp_forms[LISP_FORM_WHILE].cond);
+        if (n == 0) { return create_lv_sexpr(); }
+
+        lisp_val* x = lisp_val_eval_cells(e, argv[1]);
+        if (lisp_val_type(x) == LISP_VAL_ERR) { return x; }
+        free_lisp_val(x);
+    }
+}
+
+// (do x ...) is its last argument, after all of them have been evaluated in order
+lisp_val* builtin_do(lisp_env* e, int argc, lisp_val** argv) {
+    return lisp_arg_take(argv, argc - 1);
+}
+
+// the message of error err, as a string
+lisp_val* lisp_err_string(lisp_val* err) {
+    char msg[512];
+    lisp_err_format(err, msg, sizeof(msg));
+    return create_lv_string(msg);
+}
+
+// (try {body} handler) is the value of the body, unless evaluating it raises an error: then it is
+// the value of the handler called with the message of the error
+lisp_val* builtin_try(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_QEXPR, ERROR_TYPE, "Argument 1 of 'try' must be q-expression");
+    lisp_val* x = lisp_val_eval_cells(e, argv[0]);
+    if (lisp_val_type(x) != LISP_VAL_ERR) { return x; }
+
+    lisp_val* v = create_lv_sexpr();
+    v = lisp_val_add(v, lisp_arg_take(argv, 1));
+    v = lisp_val_add(v, lisp_err_string(x));
+    free_lisp_val(x);
+    return lisp_val_apply(e, v);
+}
+
+// (throw "message") raises an error with the message, for a 'try' around it to catch
+lisp_val* builtin_throw(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_STRING, ERROR_TYPE, "'throw' must be passed a string.");
+    return create_lv_err_copy(ERROR_THROWN, "%s", argv[0]->str->bytes);
+}
+
+// bytecode. a lambda body compiles to code for a stack machine the first time the lambda is
+// called, so calls don't walk (and copy) its q-expression. an s-expression becomes code pushing
+// the value of each cell and a call, and a special form written out becomes jumps.
+// the operands follow their opcode in the ops. an error is never pushed: the instruction that
+// gets one raises it instead, see lisp_vm_exec
+enum {
+    LISP_OP_CONST,     // k: push constant k
+    LISP_OP_NIL,       // push ()
+    LISP_OP_LOCAL,     // k: push the formal that symbol constant k names, from its frame slot
+    LISP_OP_GLOBAL,    // k: push the value of symbol constant k, through its cached binding
+    LISP_OP_FORM,      // k, f, l: go to l if symbol constant k still names the builtin of form f
+    LISP_OP_BRANCH,    // l, f: pop the condition of form f, go to l if it is 0
+    LISP_OP_DROP,      // pop the top value
+    LISP_OP_SWAP,      // swap the top two values
+    LISP_OP_JUMP,      // l: go to l
+    LISP_OP_ENTER,     // start a new frame, inside the current one
+    LISP_OP_BIND,      // k: pop a value and bind symbol constant k to it in the frame
+    LISP_OP_LEAVE,     // drop the frame, back to the one it is inside
+    LISP_OP_CALL,      // n: replace the top n values by the value of an s-expression of them
+    LISP_OP_TAIL_CALL, // n: the same, for the last call of the body
+    LISP_OP_APPLY,     // k: push the value of s-expression constant k, evaluating it cell by cell
+    LISP_OP_RAISE,     // k: raise error constant k
+    LISP_OP_RETURN     // return the value on top
+};
+
+char* lisp_op_names[] = { "const", "nil", "local", "global", "form", "branch", "drop", "swap",
+    "jump", "enter", "bind", "leave", "call", "tail-call", "apply", "raise", "return" };
+int lisp_op_operands[] = { 1, 0, 1, 1, 3, 2, 0, 0, 1, 0, 1, 0, 1, 1, 1, 1, 0 };
+
+// evaluation limits. LISP_MAX_DEPTH bounds the lambda calls in progress, which the VM keeps on the
+// heap. LISP_MAX_NESTING bounds the runs of the VM inside one another, which do take C stack: one
+// starts whenever a builtin like 'eval' evaluates code itself. it also
+// bounds how deeply the s-expressions of the code compiled for one run may nest
+#ifndef LISP_MAX_DEPTH
+#define LISP_MAX_DEPTH 1000000
+#endif
+#ifndef LISP_MAX_NESTING
+#define LISP_MAX_NESTING 1000
+#endif
+
+typedef struct lisp_compiler {
+    lisp_code* code;
+    // number of values on the stack at the current point of the code
+    int depth;
+    // number of s-expressions the current point of the code is nested in
+    int nesting;
+    // number of 'let' frames the current point of the code is in
+    int lets;
+} lisp_compiler;
+
+// append x to the ops, returns its position
+int lisp_code_emit(lisp_code* c, int x) {
+    if (c->count == c->cap) {
+        c->cap = c->cap ? c->cap * 2 : 32;
+        c->ops = realloc(c->ops, sizeof(int) * c->cap);
+    }
+    c->ops[c->count] = x;
+    return c->count++;
+}
+
+// index of constant v in the pool
+int lisp_code_const(lisp_code* c, lisp_val* v) {
+    for (int i = 0; i < c->const_count; i++) {
+        if (c->consts[i] == v) { return i; }
+    }
+    if (c->const_count == c->const_cap) {
+        c->const_cap = c->const_cap ? c->const_cap * 2 : 8;
+        c->consts = realloc(c->consts, sizeof(lisp_val*) * c->const_cap);
+    }
+    c->consts[c->const_count] = v;
+    return c->const_count++;
+}
+
+void lisp_compile_push(lisp_compiler* c, int n) {
+    c->depth += n;
+    if (c->depth > c->code->stack) { c->code->stack = c->depth; }
+}
+
+void lisp_compile_sexpr(lisp_compiler* c, lisp_val* x, int tail);
+void lisp_compile_form(lisp_compiler* c, lisp_val* x, int tail);
+
+// code leaving the value of x on the stack
+void lisp_compile_expr(lisp_compiler* c, lisp_val* x, int tail) {
+    switch (lisp_val_type(x)) {
         case LISP_VAL_SEXPR:
-                              if(x1->count != x2->count) { return 0; }
-                              for(int i = 0; i < x1->count; i++) {
-                                  if(!lisp_val_equals(x1->cell[i], x2->cell[i])) { return 0; }
-                              }
-                              return 1;
-                              break;
-        case LISP_VAL_FUNC: 
-                              if(x1->builtin || x2->builtin) {
-                                  return x1->builtin == x2->builtin;
-                              }
-                              return lisp_val_equals(x1->formals, x2->formals)
-                                  && lisp_val_equals(x1->body   , x2->body   );
+            lisp_compile_sexpr(c, x, tail);
+            return;
+        case LISP_VAL_SYMBOL:
+            lisp_code_emit(c->code, x != x->interned && x->depth == 0 && x->slot >= 0
+                ? LISP_OP_LOCAL : LISP_OP_GLOBAL);
+            break;
+        default:
+            lisp_code_emit(c->code, LISP_OP_CONST);
+            break;
+    }
+    lisp_code_emit(c->code, lisp_code_const(c->code, x));
+    lisp_compile_push(c, 1);
+}
+
+// code evaluating the cells of x, then calling the first with the rest
+void lisp_compile_call(lisp_compiler* c, lisp_val* x, int tail) {
+    for (int i = 0; i < x->count; i++) {
+        lisp_compile_expr(c, x->cell[i], 0);
+    }
+    lisp_code_emit(c->code, tail ? LISP_OP_TAIL_CALL : LISP_OP_CALL);
+    lisp_code_emit(c->code, x->count);
+    c->depth -= x->count - 1;
+}
+
+// code leaving the value of an s-expression with the cells of x on the stack
+void lisp_compile_sexpr(lisp_compiler* c, lisp_val* x, int tail) {
+    lisp_code* code = c->code;
+    if (c->nesting == LISP_MAX_NESTING) {
+        // the static error stays alive for the code to borrow
+        lisp_val* err = create_lv_err(ERROR_DEPTH, "Expression nested too deeply to evaluate.");
+        lisp_code_emit(code, LISP_OP_RAISE);
+        lisp_code_emit(code, lisp_code_const(code, err));
+        lisp_compile_push(c, 1);
+        free_lisp_val(err);
+        return;
+    }
+    c->nesting++;
+    lisp_compile_form(c, x, tail);
+    c->nesting--;
+}
+
+// the jumps to the end of a form are chained through their operands while it is compiled, each
+// holding the position of the one before (-1 for none), and all set once the end is known
+int lisp_code_chain(lisp_code* c, int chain) {
+    return lisp_code_emit(c, chain);
+}
+
+void lisp_code_resolve(lisp_code* c, int chain) {
+    while (chain >= 0) {
+        int next = c->ops[chain];
+        c->ops[chain] = c->count;
+        chain = next;
+    }
+}
+
+// BRANCH on the condition of form f on top. returns the operand to set to where a 0 goes
+int lisp_compile_branch(lisp_compiler* c, int f) {
+    lisp_code_emit(c->code, LISP_OP_BRANCH);
+    int other = lisp_code_emit(c->code, -1);
+    lisp_code_emit(c->code, f);
+    c->depth--;
+    return other;
+}
+
+// code leaving the value of special form f written out in x, as lisp_form_of found it. the
+// operands are evaluated like the builtin of the form would, only when needed
+void lisp_compile_special(lisp_compiler* c, lisp_val* x, int f, int tail) {
+    lisp_code* code = c->code;
+    int end = -1;
+    switch (f) {
+        case LISP_FORM_IF: {
+            lisp_compile_expr(c, x->cell[1], 0);
+            int other = lisp_compile_branch(c, f);
+            lisp_compile_sexpr(c, x->cell[2], tail);
+            lisp_code_emit(code, LISP_OP_JUMP);
+            end = lisp_code_chain(code, end);
+            code->ops[other] = code->count;
+            c->depth--;
+            lisp_compile_sexpr(c, x->cell[3], tail);
+            break;
+        }
+
+        // the frame only lasts until the body is done, so the body can't end in a tail call
+        case LISP_FORM_LET: {
+            lisp_val* bindings = x->cell[1];
+            lisp_code_emit(code, LISP_OP_ENTER);
+            c->lets++;
+            for (int i = 0; i < bindings->count; i++) {
+                lisp_compile_expr(c, bindings->cell[i]->cell[1], 0);
+                lisp_code_emit(code, LISP_OP_BIND);
+                lisp_code_emit(code, lisp_code_const(code, bindings->cell[i]->cell[0]));
+                c->depth--;
+            }
+            lisp_compile_sexpr(c, x->cell[2], 0);
+            lisp_code_emit(code, LISP_OP_LEAVE);
+            c->lets--;
+            break;
+        }
+
+        case LISP_FORM_COND:
+            for (int i = 1; i < x->count; i++) {
+                lisp_compile_expr(c, x->cell[i]->cell[0], 0);
+                int next = lisp_compile_branch(c, f);
+                lisp_compile_expr(c, x->cell[i]->cell[1], tail);
+                lisp_code_emit(code, LISP_OP_JUMP);
+                end = lisp_code_chain(code, end);
+                code->ops[next] = code->count;
+                c->depth--;
+            }
+            lisp_code_emit(code, LISP_OP_NIL);
+            lisp_compile_push(c, 1);
+            break;
+
+        case LISP_FORM_AND: {
+            int zero = -1;
+            for (int i = 1; i < x->count; i++) {
+                lisp_compile_expr(c, x->cell[i], 0);
+                int next = lisp_compile_branch(c, f);
+                code->ops[next] = zero;
+                zero = next;
+            }
+            lisp_code_emit(code, LISP_OP_CONST);
+            lisp_code_emit(code, lisp_code_const(code, create_lv_num(1)));
+            lisp_code_emit(code, LISP_OP_JUMP);
+            end = lisp_code_chain(code, end);
+            lisp_code_resolve(code, zero);
+            lisp_code_emit(code, LISP_OP_CONST);
+            lisp_code_emit(code, lisp_code_const(code, create_lv_num(0)));
+            lisp_compile_push(c, 1);
+            break;
+        }
+
+        case LISP_FORM_OR:
+            for (int i = 1; i < x->count; i++) {
+                lisp_compile_expr(c, x->cell[i], 0);
+                int next = lisp_compile_branch(c, f);
+                lisp_code_emit(code, LISP_OP_CONST);
+                lisp_code_emit(code, lisp_code_const(code, create_lv_num(1)));
+                lisp_code_emit(code, LISP_OP_JUMP);
+                end = lisp_code_chain(code, end);
+                code->ops[next] = code->count;
+            }
+            lisp_code_emit(code, LISP_OP_CONST);
+            lisp_code_emit(code, lisp_code_const(code, create_lv_num(0)));
+            lisp_compile_push(c, 1);
+            break;
+
+        // the loop takes no stack, and the values of the body are dropped as it goes
+        case LISP_FORM_WHILE: {
+            int loop = code->count;
+            lisp_compile_sexpr(c, x->cell[1], 0);
+            int done = lisp_compile_branch(c, f);
+            lisp_compile_sexpr(c, x->cell[2], 0);
+            lisp_code_emit(code, LISP_OP_DROP);
+            c->depth--;
+            lisp_code_emit(code, LISP_OP_JUMP);
+            lisp_code_emit(code, loop);
+            code->ops[done] = code->count;
+            lisp_code_emit(code, LISP_OP_NIL);
+            lisp_compile_push(c, 1);
+            break;
+        }
+
+        case LISP_FORM_DO:
+        case LISP_FORM_BEGIN:
+            for (int i = 1; i < x->count - 1; i++) {
+                lisp_compile_expr(c, x->cell[i], 0);
+                lisp_code_emit(code, LISP_OP_DROP);
+                c->depth--;
+            }
+            lisp_compile_expr(c, x->cell[x->count - 1], tail);
+            break;
+
+        // entering a 'try' costs nothing: an error raised in the body finds the handler in the
+        // table of the code, and only then is the handler evaluated and called with its message.
+        // the body can't end in a tail call, which would leave the 'try'
+        case LISP_FORM_TRY: {
+            lisp_try t = { code->count, 0, 0, c->depth, c->lets };
+            lisp_compile_sexpr(c, x->cell[1], 0);
+            t.end = code->count;
+            lisp_code_emit(code, LISP_OP_JUMP);
+            end = lisp_code_chain(code, end);
+            t.handler = code->count;
+            code->tries = realloc(code->tries, sizeof(lisp_try) * (code->try_count + 1));
+            code->tries[code->try_count++] = t;
+
+            // the message is where the value of the body would be
+            lisp_compile_expr(c, x->cell[2], 0);
+            lisp_code_emit(code, LISP_OP_SWAP);
+            lisp_code_emit(code, tail ? LISP_OP_TAIL_CALL : LISP_OP_CALL);
+            lisp_code_emit(code, 2);
+            c->depth--;
+            break;
+        }
     }
+    lisp_code_resolve(code, end);
 }
 
-lisp_val* builtin_order(lisp_env* e, lisp_val* v, char* op) {
-    int result;
-    if(strcmp(op, ">") == 0) {
-        result = v->cell[0]->num > v->cell[1]->num;
+// the code of lisp_compile_sexpr for x, nested no deeper than allowed
+void lisp_compile_form(lisp_compiler* c, lisp_val* x, int tail) {
+    lisp_code* code = c->code;
+    if (x->count == 0) {
+        lisp_code_emit(code, LISP_OP_NIL);
+        lisp_compile_push(c, 1);
+        return;
     }
-    else if(strcmp(op, "<") == 0) {
-        result = v->cell[0]->num < v->cell[1]->num;
+
+    // a special form is an ordinary call if its name has been bound to something else since.
+    // that call isn't compiled, since the operands would be compiled twice, for every form
+    // they are nested in
+    int f = lisp_form_of(x);
+    if (f < 0) {
+        lisp_compile_call(c, x, tail);
+        return;
     }
-    else if(strcmp(op, ">=") == 0) {
-        result = v->cell[0]->num >= v->cell[1]->num;
+    lisp_code_emit(code, LISP_OP_FORM);
+    lisp_code_emit(code, lisp_code_const(code, x->cell[0]));
+    lisp_code_emit(code, f);
+    int special = lisp_code_emit(code, -1);
+    lisp_code_emit(code, LISP_OP_APPLY);
+    lisp_code_emit(code, lisp_code_const(code, x));
+    lisp_code_emit(code, LISP_OP_JUMP);
+    int end = lisp_code_emit(code, -1);
+    code->ops[special] = code->count;
+    lisp_compile_special(c, x, f, tail);
+    code->ops[end] = code->count;
+}
+
+// compile the body of lambda f, which is evaluated as an s-expression
+lisp_code* lisp_compile_body(lisp_val* f) {
+    lisp_code* code = calloc(1, sizeof(lisp_code));
+    code->refs = 1;
+    code->arity = f->formals->count;
+    for (int i = 0; i < f->formals->count; i++) {
+        if (f->formals->cell[i]->interned == lisp_sym_rest) { code->arity = -1; }
     }
-    else if(strcmp(op, "<=") == 0) {
-        result = v->cell[0]->num <= v->cell[1]->num;
+    lisp_compiler c = { code, 0, 0, 0 };
+    lisp_compile_sexpr(&c, f->body, 1);
+    lisp_code_emit(code, LISP_OP_RETURN);
+    return code;
+}
+
+// compile the s-expression x to be evaluated on its own, borrowing from it like a lambda's code
+lisp_code* lisp_compile_eval(lisp_val* x) {
+    lisp_code* code = calloc(1, sizeof(lisp_code));
+    code->refs = 1;
+    code->arity = -1;
+    lisp_compiler c = { code, 0, 0, 0 };
+    lisp_compile_sexpr(&c, x, 0);
+    lisp_code_emit(code, LISP_OP_RETURN);
+    return code;
+}
+
+// code of the expressions evaluated as s-expressions, cached by expression until the end of the
+// top-level form, so that an expression evaluated over and over (a branch of an 'if' that isn't
+// compiled inline, or a q-expression passed to 'eval') is only compiled once. an entry holds a
+// reference to its expression, which keeps it from being freed, or changed in place (see
+// lisp_val_own), while the code borrows from it
+#ifndef LISP_EVAL_CACHE
+#define LISP_EVAL_CACHE 64
+#endif
+
+typedef struct lisp_eval_entry {
+    lisp_val* x;
+    lisp_code* code;
+} lisp_eval_entry;
+
+lisp_eval_entry lisp_eval_cache[LISP_EVAL_CACHE];
+
+// the code of expression x, from the cache
+lisp_code* lisp_eval_code(lisp_val* x) {
+    lisp_eval_entry* entry = &lisp_eval_cache[((uintptr_t) x / 16) % LISP_EVAL_CACHE];
+    if (entry->x == x) { return entry->code; }
+    if (entry->x) {
+        free_lisp_val(entry->x);
+        lisp_code_free(entry->code);
+    }
+    entry->x = lisp_val_copy(x);
+    entry->code = lisp_compile_eval(x);
+    return entry->code;
+}
+
+// empty the cache, before the region it may point into is dropped
+void lisp_eval_cache_flush() {
+    for (int i = 0; i < LISP_EVAL_CACHE; i++) {
+        if (lisp_eval_cache[i].x == NULL) { continue; }
+        free_lisp_val(lisp_eval_cache[i].x);
+        lisp_code_free(lisp_eval_cache[i].code);
+        lisp_eval_cache[i].x = NULL;
+    }
+}
+
+// give lambda f its code, if it doesn't have it yet. a lambda in the region is dropped without
+// being freed, so its code is kept with the region's instead
+void lisp_compile(lisp_val* f) {
+    if (f->code) { return; }
+    f->code = lisp_compile_body(f);
+    if (lisp_region_contains(f)) {
+        f->code->temp = 1;
+        f->code->next_temp = lisp_region_codes;
+        lisp_region_codes = f->code;
+    }
+}
+
+// an s-expression of the n values, which it takes over
+lisp_val* lisp_vm_sexpr(lisp_val** values, int n) {
+    lisp_val* v = create_lv_sexpr();
+    lisp_val_reserve(v, n);
+    memcpy(v->cell, values, sizeof(lisp_val*) * n);
+    v->count = n;
+    return v;
+}
+
+// bind in e whatever outer binds and e doesn't, so that e can take the place of outer
+void lisp_env_inherit(lisp_env* e, lisp_env* outer) {
+    for (int i = 0; i < outer->count; i++) {
+        if (lisp_env_find(e, outer->symbols[i]) < 0) {
+            lisp_env_bind(e, outer->symbols[i], lisp_val_copy(outer->lisp_vals[i]));
+        }
     }
-    free_lisp_val(v);
-    return create_lv_num(result);
 }
 
-lisp_val* builtin_gt(lisp_env* e, lisp_val* v) {
-    return builtin_order(e, v, ">");
+// template JIT. once a lambda has been called LISP_JIT_THRESHOLD times, a body built only out of
+// numbers, its own formals, arithmetic, comparisons, 'if' and calls of itself is translated into
+// x86-64 machine code, stitched together out of a fixed template for each of those shapes. the
+// code works on untagged longs, which wrap like the arithmetic builtins do; anything else is left
+// to the VM. -DLISP_NO_JIT turns it off, and it is only built on x86-64 Linux
+#ifndef LISP_JIT_THRESHOLD
+#define LISP_JIT_THRESHOLD 100
+#endif
+// self calls take C stack, so they are bounded well below LISP_MAX_DEPTH
+#ifndef LISP_JIT_MAX_DEPTH
+#define LISP_JIT_MAX_DEPTH 10000
+#endif
+#define LISP_JIT_MAX_ARGS 16
+#define LISP_JIT_MAX_GUARDS 16
+
+long lisp_jit_compiled = 0;
+long lisp_jit_rejected = 0;
+long lisp_jit_bailouts = 0;
+long lisp_jit_entries = 0;
+long lisp_jit_code_bytes = 0;
+
+#ifdef LISP_JIT
+
+// a global the code was compiled against: a builtin, a number, or the lambda itself
+enum { LISP_JIT_BUILTIN, LISP_JIT_NUM, LISP_JIT_SELF };
+
+typedef struct lisp_jit_guard {
+    lisp_val* sym;
+    int kind;
+    lisp_builtin builtin;
+    long num;
+} lisp_jit_guard;
+
+typedef struct lisp_jit {
+    void* native;
+    // global epoch the guards were last checked in
+    long epoch;
+    int guard_count;
+    lisp_jit_guard guards[];
+} lisp_jit;
+
+typedef struct lisp_jit_buf {
+    unsigned char* bytes;
+    int count;
+    int cap;
+    lisp_code* code;
+    lisp_val* formals;
+    // where the body starts, after the prologue. self calls in tail position jump back to it
+    int body;
+    // positions of the rel32 of the jumps to the bailout stub
+    int bails[64];
+    int bail_count;
+    lisp_jit_guard guards[LISP_JIT_MAX_GUARDS];
+    int guard_count;
+} lisp_jit_buf;
+
+// native code lives in mmap'd chunks, writable only while code is appended. it is never freed
+unsigned char* lisp_jit_chunk = NULL;
+size_t lisp_jit_chunk_used = 0;
+size_t lisp_jit_chunk_size = 0;
+
+// stack pointer of the C caller, to return to it straight from any depth on a bailout
+void* lisp_jit_entry_sp = NULL;
+int lisp_jit_bailed = 0;
+
+// calls native code fn with the k arguments
+long (*lisp_jit_enter)(void* fn, long* args, long k) = NULL;
+
+void lisp_jit_emit(lisp_jit_buf* j, const char* bytes, int n) {
+    if (j->count + n > j->cap) {
+        j->cap = j->cap ? j->cap * 2 : 256;
+        if (j->cap < j->count + n) { j->cap = j->count + n; }
+        j->bytes = realloc(j->bytes, j->cap);
+    }
+    memcpy(j->bytes + j->count, bytes, n);
+    j->count += n;
 }
 
-lisp_val* builtin_gte(lisp_env* e, lisp_val* v) {
-    return builtin_order(e, v, ">=");
+void lisp_jit_emit_imm(lisp_jit_buf* j, long x, int size) {
+    lisp_jit_emit(j, (const char*) &x, size);
 }
 
-lisp_val* builtin_lt(lisp_env* e, lisp_val* v) {
-    return builtin_order(e, v, "<");
+// rel32 of a jump at pos to target
+void lisp_jit_patch(lisp_jit_buf* j, int pos, int target) {
+    int rel = target - (pos + 4);
+    memcpy(j->bytes + pos, &rel, 4);
 }
 
-lisp_val* builtin_lte(lisp_env* e, lisp_val* v) {
-    return builtin_order(e, v, "<=");
+// jcc or jmp (op ending in rel32) to the bailout stub
+int lisp_jit_emit_bail(lisp_jit_buf* j, const char* op, int n) {
+    if (j->bail_count == 64) { return 0; }
+    lisp_jit_emit(j, op, n);
+    j->bails[j->bail_count++] = j->count;
+    lisp_jit_emit_imm(j, 0, 4);
+    return 1;
 }
 
-lisp_val* builtin_compare(lisp_env* e, lisp_val* v, char* op) {
-    LASSERT(v, v->count == 2, "'%s' takes only 2 arguments. Got %i", op, v->count);
-    int result;
-    if(strcmp(op, "==") == 0) {
-        result = lisp_val_equals(v->cell[0], v->cell[1]);
+// copy n bytes of code into executable memory
+void* lisp_jit_place(unsigned char* bytes, size_t n) {
+    if (lisp_jit_chunk == NULL || lisp_jit_chunk_used + n > lisp_jit_chunk_size) {
+        size_t size = 65536;
+        while (size < n) { size *= 2; }
+        void* p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) { return NULL; }
+        lisp_jit_chunk = p;
+        lisp_jit_chunk_used = 0;
+        lisp_jit_chunk_size = size;
+    } else if (mprotect(lisp_jit_chunk, lisp_jit_chunk_size, PROT_READ | PROT_WRITE) != 0) {
+        return NULL;
     }
-    else if(strcmp(op, "!=") == 0) {
-        result = !lisp_val_equals(v->cell[0], v->cell[1]);
+    unsigned char* p = lisp_jit_chunk + lisp_jit_chunk_used;
+    memcpy(p, bytes, n);
+    lisp_jit_chunk_used += (n + 15) & ~(size_t) 15;
+    lisp_jit_code_bytes += n;
+    if (mprotect(lisp_jit_chunk, lisp_jit_chunk_size, PROT_READ | PROT_EXEC) != 0) { return NULL; }
+    return p;
+}
+
+// the entry trampoline: saves the callee-saved registers and the stack pointer, pushes the
+// arguments and calls the code with the depth budget in r15
+int lisp_jit_init() {
+    lisp_jit_buf j = { 0 };
+    lisp_jit_emit(&j, "\x55\x48\x89\xe5\x53\x41\x54\x41\x55\x41\x56\x41\x57", 13);
+    lisp_jit_emit(&j, "\x48\xb8", 2);
+    lisp_jit_emit_imm(&j, (long) &lisp_jit_entry_sp, 8);
+    lisp_jit_emit(&j, "\x48\x89\x20\x49\xbf", 5);
+    lisp_jit_emit_imm(&j, LISP_JIT_MAX_DEPTH, 8);
+    // push the k arguments at rsi in order, then call rdi
+    lisp_jit_emit(&j, "\x48\x85\xd2\x74\x0b\xff\x36\x48\x83\xc6\x08\x48\xff\xca\xeb\xf0", 16);
+    lisp_jit_emit(&j, "\xff\xd7\x48\x8d\x65\xd8\x41\x5f\x41\x5e\x41\x5d\x41\x5c\x5b\x5d\xc3", 17);
+    lisp_jit_enter = lisp_jit_place(j.bytes, j.count);
+    free(j.bytes);
+    return lisp_jit_enter != NULL;
+}
+
+// record that the code depends on global sym having its current value, which is returned
+lisp_val* lisp_jit_global(lisp_jit_buf* j, lisp_val* sym) {
+    sym = sym->interned;
+    int i = lisp_env_find(lisp_global_env, sym);
+    if (i < 0 || sym->binds > 0) { return NULL; }
+    lisp_val* v = lisp_global_env->lisp_vals[i];
+
+    lisp_jit_guard g = { sym, 0, NULL, 0 };
+    if (lisp_val_type(v) == LISP_VAL_NUM) {
+        g.kind = LISP_JIT_NUM;
+        g.num = lisp_val_num(v);
+    } else if (lisp_val_type(v) == LISP_VAL_FUNC && v->builtin) {
+        g.kind = LISP_JIT_BUILTIN;
+        g.builtin = v->builtin;
+    } else if (lisp_val_type(v) == LISP_VAL_FUNC && v->code == j->code && v->env->count == 0) {
+        g.kind = LISP_JIT_SELF;
+    } else {
+        return NULL;
     }
-    free_lisp_val(v);
-    return create_lv_num(result);
+    for (int k = 0; k < j->guard_count; k++) {
+        if (j->guards[k].sym == sym) { return v; }
+    }
+    if (j->guard_count == LISP_JIT_MAX_GUARDS) { return NULL; }
+    j->guards[j->guard_count++] = g;
+    return v;
 }
 
-lisp_val* builtin_eq(lisp_env* e, lisp_val* v) {
-    return builtin_compare(e, v, "==");
+// index of the formal x names, -1 if it isn't one
+int lisp_jit_formal(lisp_jit_buf* j, lisp_val* x) {
+    for (int i = 0; i < j->formals->count; i++) {
+        if (j->formals->cell[i]->interned == x->interned) { return i; }
+    }
+    return -1;
+}
+
+// mov between rax and formal i: [rbp + 16 + 8 * (k - 1 - i)], as pushed by the caller
+void lisp_jit_emit_formal(lisp_jit_buf* j, const char* op, int i) {
+    int disp = 16 + 8 * (j->formals->count - 1 - i);
+    lisp_jit_emit(j, op, 2);
+    if (disp < 128) {
+        lisp_jit_emit(j, "\x45", 1);
+        lisp_jit_emit_imm(j, disp, 1);
+    } else {
+        lisp_jit_emit(j, "\x85", 1);
+        lisp_jit_emit_imm(j, disp, 4);
+    }
 }
 
-lisp_val* builtin_neq(lisp_env* e, lisp_val* v) {
-    return builtin_compare(e, v, "!=");
+int lisp_jit_sexpr(lisp_jit_buf* j, lisp_val** cells, int count, int tail);
+
+// code leaving the value of x in rax. returns 0 if x can't be compiled
+int lisp_jit_value(lisp_jit_buf* j, lisp_val* x, int tail) {
+    switch (lisp_val_type(x)) {
+        case LISP_VAL_NUM:
+            lisp_jit_emit(j, "\x48\xb8", 2);
+            lisp_jit_emit_imm(j, lisp_val_num(x), 8);
+            return 1;
+        case LISP_VAL_SYMBOL: {
+            int i = lisp_jit_formal(j, x);
+            if (i >= 0) {
+                lisp_jit_emit_formal(j, "\x48\x8b", i);
+                return 1;
+            }
+            lisp_val* v = lisp_jit_global(j, x);
+            if (v == NULL || lisp_val_type(v) != LISP_VAL_NUM) { return 0; }
+            lisp_jit_emit(j, "\x48\xb8", 2);
+            lisp_jit_emit_imm(j, lisp_val_num(v), 8);
+            return 1;
+        }
+        case LISP_VAL_SEXPR:
+            return lisp_jit_sexpr(j, x->cell, x->count, tail);
+    }
+    return 0;
+}
+
+// code for an 'if' with the branches in qexprs
+int lisp_jit_if(lisp_jit_buf* j, lisp_val** cells, int tail) {
+    if (!lisp_jit_value(j, cells[1], 0)) { return 0; }
+    // test rax, rax; jz else
+    lisp_jit_emit(j, "\x48\x85\xc0\x0f\x84", 5);
+    int other = j->count;
+    lisp_jit_emit_imm(j, 0, 4);
+    if (!lisp_jit_sexpr(j, cells[2]->cell, cells[2]->count, tail)) { return 0; }
+    lisp_jit_emit(j, "\xe9", 1);
+    int end = j->count;
+    lisp_jit_emit_imm(j, 0, 4);
+    lisp_jit_patch(j, other, j->count);
+    if (!lisp_jit_sexpr(j, cells[3]->cell, cells[3]->count, tail)) { return 0; }
+    lisp_jit_patch(j, end, j->count);
+    return 1;
+}
+
+// code for a call of the lambda itself. in tail position the arguments replace the formals and
+// the body starts over
+int lisp_jit_self(lisp_jit_buf* j, lisp_val** cells, int count, int tail) {
+    int k = count - 1;
+    if (k != j->formals->count) { return 0; }
+    for (int i = 1; i < count; i++) {
+        if (!lisp_jit_value(j, cells[i], 0)) { return 0; }
+        lisp_jit_emit(j, "\x50", 1);
+    }
+    if (tail) {
+        for (int i = k - 1; i >= 0; i--) {
+            lisp_jit_emit(j, "\x58", 1);
+            lisp_jit_emit_formal(j, "\x48\x89", i);
+        }
+        lisp_jit_emit(j, "\xe9", 1);
+        lisp_jit_emit_imm(j, 0, 4);
+        lisp_jit_patch(j, j->count - 4, j->body);
+        return 1;
+    }
+    lisp_jit_emit(j, "\xe8", 1);
+    lisp_jit_emit_imm(j, 0, 4);
+    lisp_jit_patch(j, j->count - 4, 0);
+    if (k > 0) {
+        // add rsp, 8 * k
+        lisp_jit_emit(j, "\x48\x81\xc4", 3);
+        lisp_jit_emit_imm(j, 8 * k, 4);
+    }
+    return 1;
+}
+
+// code for a call of an arithmetic or comparison builtin
+int lisp_jit_builtin(lisp_jit_buf* j, lisp_builtin b, lisp_val** cells, int count) {
+    const char* op = NULL;
+    const char* set = NULL;
+    if (b == builtin_add) { op = "\x48\x01\xc8"; }
+    else if (b == builtin_sub) { op = "\x48\x29\xc8"; }
+    else if (b == builtin_mul) { op = "\x48\x0f\xaf\xc1"; }
+    else if (b == builtin_div) { op = ""; }
+    else if (b == builtin_lt) { set = "\x0f\x9c\xc0"; }
+    else if (b == builtin_gt) { set = "\x0f\x9f\xc0"; }
+    else if (b == builtin_lte) { set = "\x0f\x9e\xc0"; }
+    else if (b == builtin_gte) { set = "\x0f\x9d\xc0"; }
+    else if (b == builtin_eq) { set = "\x0f\x94\xc0"; }
+    else if (b == builtin_neq) { set = "\x0f\x95\xc0"; }
+    else { return 0; }
+    if (count < 2 || (set && count != 3)) { return 0; }
+
+    if (!lisp_jit_value(j, cells[1], 0)) { return 0; }
+    if (count == 2) {
+        // (- x) negates, the others leave x as it is
+        if (b == builtin_sub) { lisp_jit_emit(j, "\x48\xf7\xd8", 3); }
+        return 1;
+    }
+    for (int i = 2; i < count; i++) {
+        // push rax; <arg>; mov rcx, rax; pop rax
+        lisp_jit_emit(j, "\x50", 1);
+        if (!lisp_jit_value(j, cells[i], 0)) { return 0; }
+        lisp_jit_emit(j, "\x48\x89\xc1\x58", 4);
+        if (set) {
+            // cmp rax, rcx; setcc al; movzx eax, al
+            lisp_jit_emit(j, "\x48\x39\xc8", 3);
+            lisp_jit_emit(j, set, 3);
+            lisp_jit_emit(j, "\x0f\xb6\xc0", 3);
+        } else if (b == builtin_div) {
+            // division by zero is an error, and LONG_MIN / -1 traps: both are left to the VM
+            if (!lisp_jit_emit_bail(j, "\x48\x85\xc9\x0f\x84", 5)) { return 0; }
+            if (!lisp_jit_emit_bail(j, "\x48\x83\xf9\xff\x0f\x84", 6)) { return 0; }
+            lisp_jit_emit(j, "\x48\x99\x48\xf7\xf9", 5);
+        } else {
+            lisp_jit_emit(j, op, strlen(op));
+        }
+    }
+    return 1;
+}
+
+// code leaving the value of an s-expression with the cells in rax
+int lisp_jit_sexpr(lisp_jit_buf* j, lisp_val** cells, int count, int tail) {
+    if (count == 0) { return 0; }
+    if (count == 1) { return lisp_jit_value(j, cells[0], tail); }
+    if (lisp_val_type(cells[0]) != LISP_VAL_SYMBOL || lisp_jit_formal(j, cells[0]) >= 0) { return 0; }
+    lisp_val* f = lisp_jit_global(j, cells[0]);
+    if (f == NULL || lisp_val_type(f) != LISP_VAL_FUNC) { return 0; }
+    if (f->builtin == builtin_if) {
+        if (count != 4 || lisp_val_type(cells[2]) != LISP_VAL_QEXPR || lisp_val_type(cells[3]) != LISP_VAL_QEXPR) {
+            return 0;
+        }
+        return lisp_jit_if(j, cells, tail);
+    }
+    if (f->builtin) { return lisp_jit_builtin(j, f->builtin, cells, count); }
+    return lisp_jit_self(j, cells, count, tail);
+}
+
+// compile lambda f, NULL if its body isn't made only of what the JIT handles
+lisp_jit* lisp_jit_compile(lisp_val* f) {
+    if (lisp_jit_enter == NULL && !lisp_jit_init()) { return NULL; }
+    if (f->code->arity < 0 || f->code->arity > LISP_JIT_MAX_ARGS) { return NULL; }
+
+    lisp_jit_buf j = { 0 };
+    j.code = f->code;
+    j.formals = f->formals;
+    // push rbp; mov rbp, rsp; dec r15; jz bail
+    lisp_jit_emit(&j, "\x55\x48\x89\xe5", 4);
+    lisp_jit_emit_bail(&j, "\x49\xff\xcf\x0f\x84", 5);
+    j.body = j.count;
+    int ok = lisp_jit_sexpr(&j, f->body->cell, f->body->count, 1);
+    // inc r15; leave; ret
+    lisp_jit_emit(&j, "\x49\xff\xc7\xc9\xc3", 5);
+
+    // the bailout stub flags the bailout and returns from the trampoline with its saved registers
+    for (int i = 0; i < j.bail_count; i++) { lisp_jit_patch(&j, j.bails[i], j.count); }
+    lisp_jit_emit(&j, "\x48\xb8", 2);
+    lisp_jit_emit_imm(&j, (long) &lisp_jit_bailed, 8);
+    lisp_jit_emit(&j, "\xc7\x00\x01\x00\x00\x00\x48\xb8", 8);
+    lisp_jit_emit_imm(&j, (long) &lisp_jit_entry_sp, 8);
+    lisp_jit_emit(&j, "\x48\x8b\x20\x41\x5f\x41\x5e\x41\x5d\x41\x5c\x5b\x5d\xc3", 14);
+
+    void* native = ok ? lisp_jit_place(j.bytes, j.count) : NULL;
+    free(j.bytes);
+    if (native == NULL) { return NULL; }
+    lisp_jit* jit = malloc(sizeof(lisp_jit) + sizeof(lisp_jit_guard) * j.guard_count);
+    jit->native = native;
+    jit->epoch = lisp_global_epoch;
+    jit->guard_count = j.guard_count;
+    memcpy(jit->guards, j.guards, sizeof(lisp_jit_guard) * j.guard_count);
+    return jit;
+}
+
+// whether the globals of the code of c still are what it was compiled against, and no frame
+// binds their names in their place
+int lisp_jit_check(lisp_jit* jit, lisp_code* c) {
+    for (int i = 0; i < jit->guard_count; i++) {
+        if (jit->guards[i].sym->binds > 0) { return 0; }
+    }
+    if (jit->epoch == lisp_global_epoch) { return 1; }
+    for (int i = 0; i < jit->guard_count; i++) {
+        lisp_jit_guard* g = &jit->guards[i];
+        int k = lisp_env_find(lisp_global_env, g->sym);
+        if (k < 0) { return 0; }
+        lisp_val* v = lisp_global_env->lisp_vals[k];
+        int type = lisp_val_type(v);
+        if (g->kind == LISP_JIT_NUM && !(type == LISP_VAL_NUM && lisp_val_num(v) == g->num)) { return 0; }
+        if (g->kind == LISP_JIT_BUILTIN && !(type == LISP_VAL_FUNC && v->builtin == g->builtin)) { return 0; }
+        if (g->kind == LISP_JIT_SELF
+                && !(type == LISP_VAL_FUNC && !v->builtin && v->code == c && v->env->count == 0)) {
+            return 0;
+        }
+    }
+    jit->epoch = lisp_global_epoch;
+    return 1;
+}
+
+// the value of calling lambda f, whose code takes exactly the k arguments, natively. NULL if
+// the call is left to the VM. the arguments are borrowed
+lisp_val* lisp_jit_call(lisp_val* f, lisp_val** args, int k) {
+    lisp_code* c = f->code;
+    if (c->jit == NULL) {
+        if (c->temp || c->calls < 0 || ++c->calls < LISP_JIT_THRESHOLD) { return NULL; }
+        c->jit = lisp_jit_compile(f);
+        if (c->jit == NULL) {
+            c->calls = -1;
+            lisp_jit_rejected++;
+            return NULL;
+        }
+        lisp_jit_compiled++;
+    }
+
+    long nums[LISP_JIT_MAX_ARGS];
+    for (int i = 0; i < k; i++) {
+        if (lisp_val_type(args[i]) != LISP_VAL_NUM) { return NULL; }
+        nums[i] = lisp_val_num(args[i]);
+    }
+    if (!lisp_jit_check(c->jit, c)) { return NULL; }
+
+    lisp_jit_entries++;
+    lisp_jit_bailed = 0;
+    long x = lisp_jit_enter(c->jit->native, nums, k);
+    if (lisp_jit_bailed) {
+        // the code has no side effects, so the VM just runs the call again. it keeps running it
+        // from then on, rather than bailing out of the native code over and over
+        lisp_jit_bailouts++;
+        free(c->jit);
+        c->jit = NULL;
+        c->calls = -1;
+        return NULL;
+    }
+    return create_lv_num(x);
 }
 
-lisp_val* builtin_if(lisp_env* e, lisp_val* v) {
-    LASSERT(v, v->count == 3, "'if' takes 3 arguments. Got %i", v->count);
-    LASSERT(v, v->cell[0]->type == LISP_VAL_NUM, "Argument 1 of 'if' must be bool");
-    LASSERT(v, v->cell[1]->type == LISP_VAL_QEXPR, "Argument 1 of 'if' must be q-expression");
-    LASSERT(v, v->cell[2]->type == LISP_VAL_QEXPR, "Argument 2 of 'if' must be q-expression");
+#endif
+
+// bind a call of the callable lambda on the stack with the n - 1 values after it, taking the values
+// over. a compiled lambda taking exactly those binds them straight off the stack, unless the JIT
+// runs it natively. returns the frame to run the body in, or NULL with the result when there is
+// none to run (and the lambda is freed)
+lisp_env* lisp_vm_bind(lisp_val** values, int n, lisp_val** result) {
+    lisp_val* g = values[0];
+    lisp_compile(g);
+    if (g->env->count > 0 || g->code->arity != n - 1) {
+        return lisp_val_bind(g, lisp_vm_sexpr(&values[1], n - 1), result);
+    }
+#ifdef LISP_JIT
+    if ((*result = lisp_jit_call(g, &values[1], n - 1))) {
+        for (int i = 0; i < n; i++) { free_lisp_val(values[i]); }
+        return NULL;
+    }
+#endif
+
+    lisp_env* frame = create_lisp_env();
+    lisp_env_alloc_entries(frame, n - 1);
+    for (int i = 1; i < n; i++) {
+        lisp_env_bind(frame, g->formals->cell[i - 1]->interned, values[i]);
+    }
+    return frame;
+}
+
+// a call in progress, waiting for the value of a lambda call it made. f is NULL for an expression.
+// frame is the innermost of its frames, inside lets frames of 'let's in its own
+typedef struct lisp_vm_call {
+    lisp_val* f;
+    lisp_code* code;
+    lisp_env* frame;
+    int pc;
+    int base;
+    int lets;
+} lisp_vm_call;
+
+// the value stack and the call stack, shared by the runs of the VM: a run nested in another uses
+// the part above the values in use by the outer one, which are below lisp_vm_top
+lisp_val** lisp_vm_stack = NULL;
+int lisp_vm_stack_size = 0;
+int lisp_vm_top = 0;
+lisp_vm_call* lisp_vm_calls = NULL;
+int lisp_vm_call_count = 0;
+int lisp_vm_call_size = 0;
+int lisp_vm_nesting = 0;
+
+// make room on the value stack for n values above sp
+void lisp_vm_reserve(int sp, int n) {
+    if (sp + n <= lisp_vm_stack_size) { return; }
+    lisp_vm_stack_size = lisp_vm_stack_size ? lisp_vm_stack_size * 2 : 256;
+    if (lisp_vm_stack_size < sp + n) { lisp_vm_stack_size = sp + n; }
+    lisp_vm_stack = realloc(lisp_vm_stack, sizeof(lisp_val*) * lisp_vm_stack_size);
+}
+
+// call the builtin in values[0] with the n - 1 values after it. they are copied out of the stack
+// first, since the builtin may run the VM again and move it
+lisp_val* lisp_vm_call_builtin(lisp_env* e, lisp_val** values, int n) {
+    lisp_val* f = values[0];
+    lisp_val* inline_args[16];
+    lisp_val** argv = n - 1 <= 16 ? inline_args : malloc(sizeof(lisp_val*) * (n - 1));
+    memcpy(argv, &values[1], sizeof(lisp_val*) * (n - 1));
+    lisp_val* result = lisp_builtin_call(e, f, n - 1, argv);
+    lisp_args_free(n - 1, argv);
+    if (argv != inline_args) { free(argv); }
+    free_lisp_val(f);
+    return result;
+}
+
+// with GCC, each instruction of the code is run by jumping straight to the address of its handler,
+// looked up once per code instead of once per instruction. LISP_VM_SWITCH dispatches on the opcode
+#if defined(__GNUC__) && !defined(LISP_VM_SWITCH)
+#define LISP_VM_THREADED
+#define LISP_VM_DISPATCH goto *handlers[pc];
+#define LISP_VM_OP(op) op
+#define LISP_VM_NEXT goto *handlers[pc]
+#else
+#define LISP_VM_DISPATCH switch (ops[pc])
+#define LISP_VM_OP(op) case op
+#define LISP_VM_NEXT break
+#endif
+
+// the handler of each instruction of code c, out of the labels of the opcodes
+void lisp_code_thread(lisp_code* c, void* const* labels) {
+    c->handlers = malloc(sizeof(void*) * c->count);
+    for (int pc = 0; pc < c->count; pc += 1 + lisp_op_operands[c->ops[pc]]) {
+        c->handlers[pc] = labels[c->ops[pc]];
+    }
+}
 
+// the innermost 'try' of code around the instruction at pc, NULL if there is none
+lisp_try* lisp_code_try(lisp_code* code, int pc) {
+    for (int i = 0; i < code->try_count; i++) {
+        if (pc >= code->tries[i].start && pc < code->tries[i].end) { return &code->tries[i]; }
+    }
+    return NULL;
+}
+
+// drop the frame of a 'let', returns the one it was inside
+lisp_env* lisp_env_leave(lisp_env* frame) {
+    lisp_env* outer = frame->parent;
+    free_lisp_env(frame);
+    return outer;
+}
+
+// run code in frame until it returns. the code is the body of lambda f, which owns the frame and
+// is taken over with it, or for f == NULL an expression evaluated in an env of the caller.
+// a call of a lambda suspends the caller on the call stack and runs the callee in the same loop; in
+// tail position the callee's frame replaces the caller's instead. either way the C stack doesn't grow.
+// an error is raised by the instruction that gets it, and ends the run unless a 'try' catches it
+lisp_val* lisp_vm_exec(lisp_val* f, lisp_code* code, lisp_env* frame) {
+    if (lisp_vm_nesting == LISP_MAX_NESTING) {
+        if (f) {
+            free_lisp_env(frame);
+            free_lisp_val(f);
+        }
+        return create_lv_err(ERROR_DEPTH, "Evaluation nested too deeply.");
+    }
+    lisp_vm_nesting++;
+    int top = lisp_vm_top;
+    int entry = lisp_vm_call_count;
+    int base = top;
+    int sp = base;
+    int pc = 0;
+    int lets = 0;
     lisp_val* result;
 
-    v->cell[1]->type = LISP_VAL_SEXPR;
-    v->cell[2]->type = LISP_VAL_SEXPR;
-    if(v->cell[0]->num) {
-        result = lisp_val_eval(e, lisp_val_pop(v, 1));
+start:
+    lisp_vm_reserve(sp, code->stack);
+    lisp_val** stack = lisp_vm_stack;
+    int* ops = code->ops;
+    lisp_val** consts = code->consts;
+#ifdef LISP_VM_THREADED
+    static void* const labels[] = {
+        [LISP_OP_CONST] = &&LISP_OP_CONST, [LISP_OP_NIL] = &&LISP_OP_NIL, [LISP_OP_LOCAL] = &&LISP_OP_LOCAL,
+        [LISP_OP_GLOBAL] = &&LISP_OP_GLOBAL, [LISP_OP_FORM] = &&LISP_OP_FORM, [LISP_OP_BRANCH] = &&LISP_OP_BRANCH,
+        [LISP_OP_DROP] = &&LISP_OP_DROP, [LISP_OP_SWAP] = &&LISP_OP_SWAP, [LISP_OP_JUMP] = &&LISP_OP_JUMP,
+        [LISP_OP_ENTER] = &&LISP_OP_ENTER, [LISP_OP_BIND] = &&LISP_OP_BIND, [LISP_OP_LEAVE] = &&LISP_OP_LEAVE,
+        [LISP_OP_CALL] = &&LISP_OP_CALL, [LISP_OP_TAIL_CALL] = &&LISP_OP_TAIL_CALL,
+        [LISP_OP_APPLY] = &&LISP_OP_APPLY, [LISP_OP_RAISE] = &&LISP_OP_RAISE,
+        [LISP_OP_RETURN] = &&LISP_OP_RETURN };
+    if (code->handlers == NULL) { lisp_code_thread(code, labels); }
+    void** handlers = code->handlers;
+#endif
+
+    for (;;) {
+        LISP_VM_DISPATCH {
+            LISP_VM_OP(LISP_OP_CONST):
+                stack[sp++] = lisp_val_copy(consts[ops[pc + 1]]);
+                pc += 2;
+                LISP_VM_NEXT;
+
+            LISP_VM_OP(LISP_OP_NIL):
+                stack[sp++] = create_lv_sexpr();
+                pc += 1;
+                LISP_VM_NEXT;
+
+            LISP_VM_OP(LISP_OP_LOCAL): {
+                lisp_val* k = consts[ops[pc + 1]];
+                if (k->slot < frame->count && frame->symbols[k->slot] == k->interned) {
+                    stack[sp++] = lisp_val_copy(frame->lisp_vals[k->slot]);
+                    pc += 2;
+                    LISP_VM_NEXT;
+                }
+                result = lisp_env_get(frame, k);
+                if (lisp_val_type(result) == LISP_VAL_ERR) { goto raise; }
+                stack[sp++] = result;
+                pc += 2;
+                LISP_VM_NEXT;
+            }
+
+            LISP_VM_OP(LISP_OP_GLOBAL):
+                result = lisp_env_get(frame, consts[ops[pc + 1]]);
+                if (lisp_val_type(result) == LISP_VAL_ERR) { goto raise; }
+                stack[sp++] = result;
+                pc += 2;
+                LISP_VM_NEXT;
+
+            LISP_VM_OP(LISP_OP_FORM): {
+                lisp_val* x = lisp_env_get(frame, consts[ops[pc + 1]]);
+                int builtin = lisp_val_type(x) == LISP_VAL_FUNC && x->builtin == lisp_forms[ops[pc + 2]].builtin;
+                free_lisp_val(x);
+                pc = builtin ? ops[pc + 3] : pc + 4;
+                LISP_VM_NEXT;
+            }
+
+            LISP_VM_OP(LISP_OP_BRANCH): {
+                lisp_val* x = stack[--sp];
+                if (lisp_val_type(x) != LISP_VAL_NUM) {
+                    free_lisp_val(x);
+                    result = create_lv_err(ERROR_TYPE, "%s", lisp_forms[ops[pc + 2]].cond);
+                    goto raise;
+                }
+                pc = lisp_val_num(x) ? pc + 3 : ops[pc + 1];
+                free_lisp_val(x);
+                LISP_VM_NEXT;
+            }
+
+            LISP_VM_OP(LISP_OP_DROP):
+                free_lisp_val(stack[--sp]);
+                pc += 1;
+                LISP_VM_NEXT;
+
+            LISP_VM_OP(LISP_OP_SWAP): {
+                lisp_val* x = stack[sp - 1];
+                stack[sp - 1] = stack[sp - 2];
+                stack[sp - 2] = x;
+                pc += 1;
+                LISP_VM_NEXT;
+            }
+
+            LISP_VM_OP(LISP_OP_JUMP):
+                pc = ops[pc + 1];
+                LISP_VM_NEXT;
+
+            // the frames of a 'let' are nested in the frame of the call, which the call records and
+            // lookups already know how to search, so they need nothing else to be found
+            LISP_VM_OP(LISP_OP_ENTER): {
+                lisp_env* inner = create_lisp_env();
+                inner->parent = frame;
+                frame = inner;
+                lets++;
+                pc += 1;
+                LISP_VM_NEXT;
+            }
+
+            LISP_VM_OP(LISP_OP_BIND): {
+                lisp_val* x = stack[--sp];
+                lisp_env_put(frame, consts[ops[pc + 1]], x);
+                free_lisp_val(x);
+                pc += 2;
+                LISP_VM_NEXT;
+            }
+
+            LISP_VM_OP(LISP_OP_LEAVE):
+                frame = lisp_env_leave(frame);
+                lets--;
+                pc += 1;
+                LISP_VM_NEXT;
+
+            LISP_VM_OP(LISP_OP_TAIL_CALL): {
+                int n = ops[pc + 1];
+                // a single cell is a value, not a call, even when it is a lambda taking no
+                // arguments: it is left to LISP_OP_CALL below
+                if (f == NULL || sp - base != n || n == 1 || lisp_val_type(stack[base]) != LISP_VAL_FUNC
+                        || stack[base]->builtin) {
+                    goto call;
+                }
+                sp = base;
+                lisp_val* g = stack[base];
+                lisp_env* next = lisp_vm_bind(&stack[base], n, &result);
+                if (next == NULL) {
+                    if (lisp_val_type(result) == LISP_VAL_ERR) { goto raise; }
+                    stack[sp++] = result;
+                    pc += 2;
+                    LISP_VM_NEXT;
+                }
+
+                // the callee's frame replaces this one. anything only this frame binds could still
+                // be looked up by the callee through it, so it moves over
+                lisp_env_inherit(next, frame);
+                next->parent = frame->parent;
+                free_lisp_env(frame);
+                free_lisp_val(f);
+                f = g;
+                code = g->code;
+                frame = next;
+                pc = 0;
+                goto start;
+            }
+
+            LISP_VM_OP(LISP_OP_CALL):
+            call: {
+                int n = ops[pc + 1];
+                // a single value is the value of the s-expression, unless it runs a builtin
+                lisp_val* x = stack[sp - 1];
+                if (n == 1 && !(lisp_val_type(x) == LISP_VAL_FUNC && x->builtin && x->max_args == 0)) {
+                    pc += 2;
+                    LISP_VM_NEXT;
+                }
+                sp -= n;
+                lisp_val* g = stack[sp];
+                int callable = n > 1 && lisp_val_type(g) == LISP_VAL_FUNC;
+
+                if (callable && !g->builtin) {
+                    if (lisp_vm_call_count == LISP_MAX_DEPTH) {
+                        for (int i = 0; i < n; i++) { free_lisp_val(stack[sp + i]); }
+                        result = create_lv_err(ERROR_DEPTH, "Maximum call depth exceeded.");
+                        goto raise;
+                    }
+                    lisp_env* next = lisp_vm_bind(&stack[sp], n, &result);
+                    if (next == NULL) {
+                        if (lisp_val_type(result) == LISP_VAL_ERR) { goto raise; }
+                        stack[sp++] = result;
+                        pc += 2;
+                        LISP_VM_NEXT;
+                    }
+
+                    // suspend this call, the callee's values go where the call's were
+                    if (lisp_vm_call_count == lisp_vm_call_size) {
+                        lisp_vm_call_size = lisp_vm_call_size ? lisp_vm_call_size * 2 : 64;
+                        lisp_vm_calls = realloc(lisp_vm_calls, sizeof(lisp_vm_call) * lisp_vm_call_size);
+                    }
+                    lisp_vm_calls[lisp_vm_call_count++] = (lisp_vm_call) { f, code, frame, pc + 2, base, lets };
+                    next->parent = frame;
+                    f = g;
+                    code = g->code;
+                    frame = next;
+                    base = sp;
+                    pc = 0;
+                    lets = 0;
+                    goto start;
+                }
+
+                // builtins are called directly, anything else is applied like an s-expression of
+                // the values. either may run the VM again, above the values in use here
+                lisp_vm_top = sp;
+                if (callable) {
+                    result = lisp_vm_call_builtin(frame, &stack[sp], n);
+                } else {
+                    result = lisp_val_apply(frame, lisp_vm_sexpr(&stack[sp], n));
+                }
+                stack = lisp_vm_stack;
+                if (lisp_val_type(result) == LISP_VAL_ERR) { goto raise; }
+                stack[sp++] = result;
+                pc += 2;
+                LISP_VM_NEXT;
+            }
+
+            LISP_VM_OP(LISP_OP_APPLY):
+                lisp_vm_top = sp;
+                result = lisp_val_eval_each(frame, consts[ops[pc + 1]]);
+                stack = lisp_vm_stack;
+                if (lisp_val_type(result) == LISP_VAL_ERR) { goto raise; }
+                stack[sp++] = result;
+                pc += 2;
+                LISP_VM_NEXT;
+
+            LISP_VM_OP(LISP_OP_RAISE):
+                result = lisp_val_copy(consts[ops[pc + 1]]);
+                goto raise;
+
+            LISP_VM_OP(LISP_OP_RETURN):
+                result = stack[--sp];
+                if (f) {
+                    free_lisp_env(frame);
+                    free_lisp_val(f);
+                }
+                if (lisp_vm_call_count == entry) {
+                    lisp_vm_top = top;
+                    lisp_vm_nesting--;
+                    return result;
+                }
+
+                // resume the caller with the value of its call
+                lisp_vm_call* caller = &lisp_vm_calls[--lisp_vm_call_count];
+                f = caller->f;
+                code = caller->code;
+                frame = caller->frame;
+                pc = caller->pc;
+                sp = base;
+                base = caller->base;
+                lets = caller->lets;
+                stack[sp++] = result;
+                goto start;
+        }
     }
-    else {
-        result = lisp_val_eval(e, lisp_val_pop(v, 2));
+
+    // error 'result' was raised by the instruction at pc. whatever is in progress up to the
+    // innermost 'try' around it is dropped at once, without evaluating anything more: values,
+    // 'let' frames, and lambda calls, which are resumed at their call only to look for a 'try'.
+    // the handler of the try starts with the message of the error on the stack
+raise:
+    stack = lisp_vm_stack;
+    for (;;) {
+        lisp_try* t = lisp_code_try(code, pc);
+        if (t) {
+            for (; lets > t->lets; lets--) { frame = lisp_env_leave(frame); }
+            while (sp > base + t->depth) { free_lisp_val(stack[--sp]); }
+            stack[sp++] = lisp_err_string(result);
+            free_lisp_val(result);
+            pc = t->handler;
+            goto start;
+        }
+
+        for (; lets > 0; lets--) { frame = lisp_env_leave(frame); }
+        while (sp > base) { free_lisp_val(stack[--sp]); }
+        if (f) {
+            free_lisp_env(frame);
+            free_lisp_val(f);
+        }
+        if (lisp_vm_call_count == entry) {
+            lisp_vm_top = top;
+            lisp_vm_nesting--;
+            return result;
+        }
+        lisp_vm_call* caller = &lisp_vm_calls[--lisp_vm_call_count];
+        f = caller->f;
+        code = caller->code;
+        frame = caller->frame;
+        pc = caller->pc - 2;
+        base = caller->base;
+        lets = caller->lets;
     }
+}
 
-    free_lisp_val(v);
-    
-    return result;
+// run the body of lambda f in frame, as made by lisp_val_bind. takes ownership of f and frame
+lisp_val* lisp_vm_run(lisp_val* f, lisp_env* frame) {
+    lisp_compile(f);
+    return lisp_vm_exec(f, f->code, frame);
+}
+
+// print the bytecode of a lambda
+lisp_val* builtin_disassemble(lisp_env* e, int argc, lisp_val** argv) {
+    LASSERT(lisp_val_type(argv[0]) == LISP_VAL_FUNC && !argv[0]->builtin, ERROR_TYPE,
+        "Cannot disassemble a non-lambda.");
+
+    lisp_val* f = argv[0];
+    lisp_code* code = f->code ? lisp_code_copy(f->code) : lisp_compile_body(f);
+    printf("%i ops, %i constants, stack %i\n", code->count, code->const_count, code->stack);
+    for (int pc = 0; pc < code->count; pc += 1 + lisp_op_operands[code->ops[pc]]) {
+        int op = code->ops[pc];
+        printf("%4i  %-10s", pc, lisp_op_names[op]);
+        switch (op) {
+            case LISP_OP_CONST:
+            case LISP_OP_LOCAL:
+            case LISP_OP_GLOBAL:
+            case LISP_OP_BIND:
+            case LISP_OP_APPLY:
+            case LISP_OP_RAISE:
+                lisp_val_print(code->consts[code->ops[pc + 1]]);
+                break;
+            case LISP_OP_FORM:
+                lisp_val_print(code->consts[code->ops[pc + 1]]);
+                printf(" then %i", code->ops[pc + 3]);
+                break;
+            case LISP_OP_BRANCH:
+            case LISP_OP_JUMP:
+            case LISP_OP_CALL:
+            case LISP_OP_TAIL_CALL:
+                printf("%i", code->ops[pc + 1]);
+                break;
+        }
+        putchar('\n');
+    }
+    lisp_code_free(code);
+    return create_lv_sexpr();
+}
 
+lisp_val* builtin_jit_stats(lisp_env* e, int argc, lisp_val** argv) {
+    lisp_val* stats = create_lv_qexpr();
+    stats = lisp_val_add(stats, create_lv_stat("compiled", lisp_jit_compiled));
+    stats = lisp_val_add(stats, create_lv_stat("rejected", lisp_jit_rejected));
+    stats = lisp_val_add(stats, create_lv_stat("bailouts", lisp_jit_bailouts));
+    stats = lisp_val_add(stats, create_lv_stat("entries", lisp_jit_entries));
+    stats = lisp_val_add(stats, create_lv_stat("code-bytes", lisp_jit_code_bytes));
+    return stats;
 }
 
-void lisp_env_add_builtin(lisp_env* e, char* name, lisp_builtin func) {
+// bind name to builtin func, which takes min_args to max_args arguments (-1 for any number).
+// builtins taking no arguments run even when they are alone in an s-expression, e.g. (mem-stats)
+void lisp_env_add_builtin(lisp_env* e, char* name, lisp_builtin func, int min_args, int max_args) {
     lisp_val* k = create_lv_symbol(name);
-    lisp_val* v = create_lv_func(func);
+    lisp_val* v = create_lv_func(func, name, min_args, max_args);
     lisp_env_put(e, k, v);
     free_lisp_val(k);
     free_lisp_val(v);
@@ -896,43 +3702,61 @@ void lisp_env_add_builtin(lisp_env* e, char* name, lisp_builtin func) {
 
 void lisp_env_add_builtins(lisp_env* e) {
 
-    lisp_env_add_builtin(e, "list", builtin_list);
-    lisp_env_add_builtin(e, "head", builtin_head);
-    lisp_env_add_builtin(e, "tail", builtin_tail);
-    lisp_env_add_builtin(e, "eval", builtin_eval);
-    lisp_env_add_builtin(e, "join", builtin_join);
-
-    lisp_env_add_builtin(e, "+", builtin_add);
-    lisp_env_add_builtin(e, "-", builtin_sub);
-    lisp_env_add_builtin(e, "*", builtin_mul);
-    lisp_env_add_builtin(e, "/", builtin_div);
-
-    lisp_env_add_builtin(e, "def", builtin_def);
-    lisp_env_add_builtin(e, "\\", builtin_lambda);
-    lisp_env_add_builtin(e, "=", builtin_put);
-
-    lisp_env_add_builtin(e, "==", builtin_eq);
-    lisp_env_add_builtin(e, "!=", builtin_neq);
-    lisp_env_add_builtin(e, ">",  builtin_gt);
-    lisp_env_add_builtin(e, "<",  builtin_lt);
-    lisp_env_add_builtin(e, ">=", builtin_gte);
-    lisp_env_add_builtin(e, "<=", builtin_lte);
-    lisp_env_add_builtin(e, "if", builtin_if);
-       
-    lisp_env_add_builtin(e, "load",  builtin_load);
-    lisp_env_add_builtin(e, "print", builtin_print);
+    lisp_env_add_builtin(e, "list", builtin_list, 0, -1);
+    lisp_env_add_builtin(e, "head", builtin_head, 1, 1);
+    lisp_env_add_builtin(e, "tail", builtin_tail, 1, 1);
+    lisp_env_add_builtin(e, "eval", builtin_eval, 1, 1);
+    lisp_env_add_builtin(e, "join", builtin_join, 1, -1);
+
+    lisp_env_add_builtin(e, "+", builtin_add, 1, -1);
+    lisp_env_add_builtin(e, "-", builtin_sub, 1, -1);
+    lisp_env_add_builtin(e, "*", builtin_mul, 1, -1);
+    lisp_env_add_builtin(e, "/", builtin_div, 1, -1);
+
+    lisp_env_add_builtin(e, "def", builtin_def, 1, -1);
+    lisp_env_add_builtin(e, "\\", builtin_lambda, 2, 2);
+    lisp_env_add_builtin(e, "=", builtin_put, 1, -1);
+
+    lisp_env_add_builtin(e, "==", builtin_eq, 2, 2);
+    lisp_env_add_builtin(e, "!=", builtin_neq, 2, 2);
+    lisp_env_add_builtin(e, ">",  builtin_gt, 2, 2);
+    lisp_env_add_builtin(e, "<",  builtin_lt, 2, 2);
+    lisp_env_add_builtin(e, ">=", builtin_gte, 2, 2);
+    lisp_env_add_builtin(e, "<=", builtin_lte, 2, 2);
+    lisp_env_add_builtin(e, "if", builtin_if, 3, 3);
+    lisp_env_add_builtin(e, "let", builtin_let, 2, 2);
+    lisp_env_add_builtin(e, "cond", builtin_cond, 1, -1);
+    lisp_env_add_builtin(e, "and", builtin_and, 1, -1);
+    lisp_env_add_builtin(e, "or", builtin_or, 1, -1);
+    lisp_env_add_builtin(e, "while", builtin_while, 2, 2);
+    lisp_env_add_builtin(e, "do", builtin_do, 1, -1);
+    lisp_env_add_builtin(e, "begin", builtin_do, 1, -1);
+    lisp_env_add_builtin(e, "try", builtin_try, 2, 2);
+    lisp_env_add_builtin(e, "throw", builtin_throw, 1, 1);
+
+    lisp_env_add_builtin(e, "load",  builtin_load, 1, 1);
+    lisp_env_add_builtin(e, "print", builtin_print, 0, -1);
+    lisp_env_add_builtin(e, "disassemble", builtin_disassemble, 1, 1);
+
+    lisp_env_add_builtin(e, "mem-stats", builtin_mem_stats, 0, 0);
+    lisp_env_add_builtin(e, "val-sizes", builtin_val_sizes, 0, 0);
+    lisp_env_add_builtin(e, "gc", builtin_gc, 0, 0);
+    lisp_env_add_builtin(e, "gc-stats", builtin_gc_stats, 0, 0);
+    lisp_env_add_builtin(e, "intern-stats", builtin_intern_stats, 0, 0);
+    lisp_env_add_builtin(e, "clock", builtin_clock, 0, 0);
+    lisp_env_add_builtin(e, "jit-stats", builtin_jit_stats, 0, 0);
 }
 
 lisp_val* lisp_val_eval_sexpr(lisp_env* e, lisp_val* v);
 
 // evaluate lisp val.
 lisp_val* lisp_val_eval(lisp_env* e, lisp_val* v) {
-    if(v->type == LISP_VAL_SYMBOL) {
+    if(lisp_val_type(v) == LISP_VAL_SYMBOL) {
         lisp_val* x = lisp_env_get(e, v);
         free_lisp_val(v);
         return x;
     }
-    if (v->type == LISP_VAL_SEXPR) { return lisp_val_eval_sexpr(e, v); }
+    if (lisp_val_type(v) == LISP_VAL_SEXPR) { return lisp_val_eval_sexpr(e, v); }
     //if not lisp val, the value is just itself
     return v;
 }
@@ -940,32 +3764,75 @@ lisp_val* lisp_val_eval(lisp_env* e, lisp_val* v) {
 // evaluate lisp val if it is a s-expression
 lisp_val* lisp_val_eval_sexpr(lisp_env* e, lisp_val* v) {
 
-    // evaluate each cell
-    for (int i = 0; i < v->count; i++) {
-        v->cell[i] = lisp_val_eval(e, v->cell[i]);
+    lisp_val* result = lisp_val_eval_cells(e, v);
+    free_lisp_val(v);
+    return result;
+}
+
+// evaluate the cells of x, an s-expression or a q-expression, as an s-expression. x is compiled
+// and run on the VM, so that however deeply the calls nest the C stack doesn't grow, and it is
+// only read: the code borrows from it, and the caller keeps it until this returns
+lisp_val* lisp_val_eval_cells(lisp_env* e, lisp_val* x) {
+    // the code is held while it runs, in case evaluating x pushes it out of the cache
+    lisp_code* code = lisp_code_copy(lisp_eval_code(x));
+    lisp_val* result = lisp_vm_exec(NULL, code, e);
+    lisp_code_free(code);
+    return result;
+}
+
+// evaluate the cells of x one at a time, each on its own, and apply the s-expression of their values.
+// this is how a call compiled as a special form is made once its name means something else
+lisp_val* lisp_val_eval_each(lisp_env* e, lisp_val* x) {
+    lisp_val* v = create_lv_sexpr();
+    lisp_val_reserve(v, x->count);
+    for (int i = 0; i < x->count; i++) {
+        lisp_val* y = lisp_val_eval(e, lisp_val_copy(x->cell[i]));
+        // the cells after an error aren't evaluated at all
+        if (lisp_val_type(y) == LISP_VAL_ERR) {
+            free_lisp_val(v);
+            return y;
+        }
+        v->cell[v->count++] = y;
     }
+    return lisp_val_apply(e, v);
+}
+
+// the value of an s-expression whose cells have been evaluated: an error in it, the single cell, or
+// the first cell called with the rest. takes ownership of v
+lisp_val* lisp_val_apply(lisp_env* e, lisp_val* v) {
 
     // if there is an error, take the error and wipe away the rest of the lisp val
     for (int i = 0; i < v->count; i++) {
-        if (v->cell[i]->type == LISP_VAL_ERR) { return lisp_val_take(v, i); }
+        if (lisp_val_type(v->cell[i]) == LISP_VAL_ERR) { return lisp_val_take(v, i); }
     }
 
     // no cells
     if (v->count == 0) { return v; }
 
     // only one cell, so just take first child
-    if (v->count == 1) { return lisp_val_take(v, 0); }
+    if (v->count == 1) {
+        lisp_val* x = lisp_val_take(v, 0);
+        if (lisp_val_type(x) == LISP_VAL_FUNC && x->builtin && x->max_args == 0) {
+            return lisp_val_call(e, x, create_lv_sexpr());
+        }
+        return x;
+    }
 
-    lisp_val* f = lisp_val_pop(v, 0);
-    if(f->type != LISP_VAL_FUNC) {
+    lisp_val* f = v->cell[0];
+    if(lisp_val_type(f) != LISP_VAL_FUNC) {
         free_lisp_val(v);
-        free_lisp_val(f);
-        return create_lv_err("First element is not a function!");
+        return create_lv_err(ERROR_NOT_FUNC, "First element is not a function!");
     }
 
-    lisp_val* result = lisp_val_call(e, f, v);
-    free_lisp_val(f);
-    return result;
+    // a builtin gets the cells after it as its arguments, in place
+    if (f->builtin) {
+        lisp_val* result = lisp_builtin_call(e, f, v->count - 1, &v->cell[1]);
+        lisp_args_free(v->count - 1, &v->cell[1]);
+        v->count = 1;
+        free_lisp_val(v);
+        return result;
+    }
+    return lisp_val_call(e, lisp_val_pop(v, 0), v);
 }
 
 
@@ -997,21 +3864,33 @@ int main(int argc, char** argv) {
 
     printf("Clisp terminal\r\n");
     printf("Type 'exit' to exit, or ctrl-c.\r\n");
+    lisp_sym_rest = create_lv_symbol("&");
+    lisp_sym_lambda = create_lv_symbol("\\");
+    for (int i = 0; i < LISP_FORM_COUNT; i++) {
+        lisp_forms[i].sym = create_lv_symbol(lisp_forms[i].name);
+    }
     lisp_env* e = create_lisp_env();
+    lisp_global_env = e;
     lisp_env_add_builtins(e);
     if(argc >= 2) {
         for(int i = 1; i < argc; i++) {
-            lisp_val* args = lisp_val_add(create_lv_sexpr(), create_lv_string(argv[i]));
-            lisp_val* x = builtin_load(e, args);
-            if(x->type == LISP_VAL_ERR) {
+            lisp_val* path = create_lv_string(argv[i]);
+            lisp_val* x = builtin_load(e, 1, &path);
+            if(lisp_val_type(x) == LISP_VAL_ERR) {
                 lisp_val_print(x);
             }
             free_lisp_val(x);
+            free_lisp_val(path);
         }
     }
   
     while (1) {
         char* input = readline("clisp> ");
+        if (input == NULL) {
+            // end of input
+            printf("\r\n");
+            break;
+        }
         char* ex = input;
         ex[strlen(ex) - 1] = '\0';
         if(strcmp(ex, "exit") == 0) {
@@ -1021,10 +3900,12 @@ int main(int argc, char** argv) {
         // parse user input
         mpc_result_t r;
         if (mpc_parse("<stdin>", input, Lispy, &r)) {
+            lisp_toplevel_begin();
             lisp_val* lv = lisp_val_eval(e, lisp_val_read(r.output));
             lisp_val_print(lv);
             printf("\r\n");
             free_lisp_val(lv);
+            lisp_toplevel_end();
             mpc_ast_delete(r.output);
         } else {
             mpc_err_print(r.error);